@@ -16,6 +16,7 @@ AccelerationProblem::AccelerationProblem(
     Smt::Logic logic = Smt::chooseLogic<RelSet, Subs>({todo}, subs);
     this->solver = SmtFactory::modelBuildingSolver(logic, its);
     this->solver->add(guard);
+    this->coreSolver = SmtFactory::solver(logic, its);
     this->isConjunction = guard->isConjunction();
     this->proof.append(std::stringstream() << "accelerating " << guard << " wrt. " << up);
 }
@@ -78,6 +79,32 @@ RelSet AccelerationProblem::findConsistentSubset(BoolExpr e) const {
     return res;
 }
 
+/**
+ * Computes an unsat core of the given literals. Instead of building a new solver for each query,
+ * every literal is guarded by an indicator variable (asserted once in coreSolver),
+ * and the indicator variables are used as assumptions. Each literal keeps its indicator for all queries.
+ */
+BoolExprSet AccelerationProblem::computeUnsatCore(const BoolExprSet &assumptions) {
+    BoolExprSet indicatorSet;
+    std::map<int, BoolExpr> lits;
+    for (const BoolExpr &a: assumptions) {
+        const Rel &lit = a->getLit().get();
+        auto it = indicators.find(lit);
+        if (it == indicators.end()) {
+            const BoolExpr indicator = buildConst(indicatorCount++);
+            coreSolver->add((!indicator) | a);
+            it = indicators.emplace(lit, indicator).first;
+        }
+        indicatorSet.insert(it->second);
+        lits.emplace(it->second->getConst().get(), a);
+    }
+    BoolExprSet res;
+    for (const BoolExpr &indicator: coreSolver->unsatCore(indicatorSet)) {
+        res.insert(lits.at(indicator->getConst().get()));
+    }
+    return res;
+}
+
 option<unsigned int> AccelerationProblem::store(const Rel &rel, const RelSet &deps, const BoolExpr formula, bool nonterm) {
     if (res.count(rel) == 0) {
         res[rel] = std::vector<Entry>();
@@ -131,7 +158,7 @@ bool AccelerationProblem::monotonicity(const Rel &rel) {
             }
             assumptions.insert(buildLit(updated));
             assumptions.insert(buildLit(!rel));
-            const BoolExprSet &unsatCore = Smt::unsatCore(assumptions, its);
+            const BoolExprSet &unsatCore = computeUnsatCore(assumptions);
             if (!unsatCore.empty()) {
                 RelSet dependencies;
                 for (const BoolExpr &e: unsatCore) {
@@ -179,7 +206,7 @@ bool AccelerationProblem::recurrence(const Rel &rel) {
         }
         assumptions.insert(buildLit(rel));
         assumptions.insert(buildLit(!updated));
-        BoolExprSet unsatCore = Smt::unsatCore(assumptions, its);
+        BoolExprSet unsatCore = computeUnsatCore(assumptions);
         if (!unsatCore.empty()) {
             RelSet dependencies;
             for (const BoolExpr &e: unsatCore) {
@@ -233,7 +260,7 @@ bool AccelerationProblem::eventualWeakDecrease(const Rel &rel) {
             }
             assumptions.insert(buildLit(dec));
             assumptions.insert(buildLit(inc));
-            BoolExprSet unsatCore = Smt::unsatCore(assumptions, its);
+            BoolExprSet unsatCore = computeUnsatCore(assumptions);
             if (!unsatCore.empty()) {
                 RelSet dependencies;
                 for (const BoolExpr &e: unsatCore) {
@@ -287,7 +314,7 @@ bool AccelerationProblem::eventualWeakIncrease(const Rel &rel) {
         }
         assumptions.insert(buildLit(dec));
         assumptions.insert(buildLit(inc));
-        BoolExprSet unsatCore = Smt::unsatCore(assumptions, its);
+        BoolExprSet unsatCore = computeUnsatCore(assumptions);
         if (!unsatCore.empty()) {
             RelSet dependencies;
             for (const BoolExpr &e: unsatCore) {
@@ -322,7 +349,7 @@ bool AccelerationProblem::eventualWeakIncrease(const Rel &rel) {
 bool AccelerationProblem::fixpoint(const Rel &rel) {
     if (res.find(rel) == res.end()) {
         RelSet eqs;
-        VarSet vars = util::RelevantVariables::find(rel.vars(), {up}, True);
+        VarSet vars = util::RelevantVariables::find(rel.vars(), {up}, True, its);
         for (const Var& var: vars) {
             eqs.insert(Rel::buildEq(var, Expr(var).subs(up)));
         }
@@ -32,6 +32,11 @@ private:
     unsigned int validityBound;
     Proof proof;
     std::unique_ptr<Smt> solver;
+    // used for all unsat core queries, only contains implications from indicator variables to literals
+    std::unique_ptr<Smt> coreSolver;
+    RelMap<BoolExpr> indicators;
+    // indicators only occur in coreSolver, so they are numbered locally (starting at 1, as 0 cannot be negated)
+    unsigned int indicatorCount = 1;
     ITSProblem &its;
     bool isConjunction;
 
@@ -51,6 +56,7 @@ private:
     bool eventualWeakIncrease(const Rel &rel);
     bool fixpoint(const Rel &rel);
     RelSet findConsistentSubset(const BoolExpr e) const;
+    BoolExprSet computeUnsatCore(const BoolExprSet &assumptions);
     option<unsigned int> store(const Rel &rel, const RelSet &deps, const BoolExpr formula, bool nonterm = false);
 
     struct ReplacementMap {
@@ -141,7 +141,7 @@ bool AccelerationProblem::eventualWeakIncrease(const Rel &rel) {
 
 bool AccelerationProblem::fixpoint(const Rel &rel) {
     RelSet eqs;
-    VarSet vars = util::RelevantVariables::find(rel.vars(), {up}, True);
+    VarSet vars = util::RelevantVariables::find(rel.vars(), {up}, True, its);
     for (const Var& var: vars) {
         eqs.insert(Rel::buildEq(var, Expr(var).subs(up)));
     }
@@ -21,6 +21,7 @@
 #include "recurrence/recurrence.hpp"
 #include "meter/metering.hpp"
 #include "../smt/smt.hpp"
+#include "../smt/smtcallsite.hpp"
 
 #include "../its/rule.hpp"
 #include "../its/export.hpp"
@@ -69,7 +70,8 @@ bool Accelerator::simplifySimpleLoops() {
     // This is especially useful to eliminate temporary variables before metering.
     if (Config::Accel::SimplifyRulesBefore) {
         for (auto it = loops.begin(), end = loops.end(); it != end; ++it) {
-            const Rule rule = its.getRule(*it);
+            const auto ruleSnapshot = its.getRule(*it);
+            const Rule &rule = ruleSnapshot.get();
             option<Rule> simplified = Preprocess::simplifyRule(its, rule, false);
             if (simplified) {
                 this->proof.ruleTransformationProof(rule, "simplification", simplified.get(), its);
@@ -190,25 +192,36 @@ const option<LinearRule> Accelerator::chain(const LinearRule &rule) const {
         }
     }
     // chain if there are updates like x = y; y = x
+    // (the closures are computed on dense variable ids, which is much cheaper than on VarSets)
+    // In each round, the closure is extended by exactly one step, so count is the number of steps that
+    // are needed to reach p.first. Note that this does not depend on the order of the variables.
+    auto idsOfUpdate = [&](const Subs &up) {
+        std::map<VarId, VarIdSet> res;
+        for (const auto &p: up) {
+            res.emplace(its.getId(p.first), its.getIds(p.second));
+        }
+        return res;
+    };
     VarMap<unsigned> cycleLength;
-    auto up = res.getUpdate();
+    auto up = idsOfUpdate(res.getUpdate());
     for (const auto &p: up) {
-        VarSet vars = p.second.vars();
+        VarIdSet vars = p.second;
         unsigned oldSize = 0;
         unsigned count = 0;
-        while (oldSize != vars.size() && vars.find(p.first) == vars.end()) {
+        while (oldSize != vars.size() && !vars.contains(p.first)) {
             oldSize = vars.size();
             count++;
-            for (const auto& var: vars) {
+            VarIdSet next = vars;
+            for (VarId var: vars) {
                 const auto it = up.find(var);
                 if (it != up.end()) {
-                    const auto newVars = it->second.vars();
-                    vars.insert(newVars.begin(), newVars.end());
+                    next.insertAll(it->second);
                 }
             }
+            vars = std::move(next);
         }
-        if (vars.find(p.first) != vars.end() && count > 0) {
-            cycleLength[p.first] = count;
+        if (vars.contains(p.first) && count > 0) {
+            cycleLength[its.getVarById(p.first)] = count;
         }
     }
     if (!cycleLength.empty()) {
@@ -225,20 +238,19 @@ const option<LinearRule> Accelerator::chain(const LinearRule &rule) const {
     bool changed;
     do {
         changed = false;
-        up = res.getUpdate();
+        up = idsOfUpdate(res.getUpdate());
         for (const auto &p: up) {
-            VarSet varsOneStep = p.second.vars();
-            VarSet varsTwoSteps;
-            for (const auto &var: varsOneStep) {
+            const VarIdSet &varsOneStep = p.second;
+            VarIdSet varsTwoSteps;
+            for (VarId var: varsOneStep) {
                 const auto it = up.find(var);
                 if (it != up.end()) {
-                    const auto newVars = it->second.vars();
-                    varsTwoSteps.insert(newVars.begin(), newVars.end());
+                    varsTwoSteps.insertAll(it->second);
                 } else {
                     varsTwoSteps.insert(var);
                 }
             }
-            if (varsTwoSteps.size() < varsOneStep.size() && std::includes(varsOneStep.begin(), varsOneStep.end(), varsTwoSteps.begin(), varsTwoSteps.end())) {
+            if (varsTwoSteps.size() < varsOneStep.size() && varsOneStep.includes(varsTwoSteps)) {
                 res = Chaining::chainRules(its, res, res, false).get();
                 chained = true;
                 changed = true;
@@ -383,7 +395,8 @@ option<Proof> Accelerator::run() {
     std::unordered_map<TransIdx, NestingCandidate> origRules;
     vector<NestingCandidate> nestingCandidates;
     for (TransIdx loop : loops) {
-        const Rule r = its.getRule(loop);
+        const auto rSnapshot = its.getRule(loop);
+        const Rule &r = rSnapshot.get();
         if (r.isLinear()) {
             Complexity cpx =
                     Config::Analysis::nonTermination() ?
@@ -399,7 +412,8 @@ option<Proof> Accelerator::run() {
     // Try to accelerate all loops
     for (TransIdx loop : loops) {
         // Forward and backward accelerate (and partial deletion for nonlinear rules)
-        const Rule r = its.getRule(loop);
+        const auto rSnapshot = its.getRule(loop);
+        const Rule &r = rSnapshot.get();
         Complexity cpx = r.isLinear() ? origRules[loop].cpx : Complexity::Unknown;
         Acceleration::Result res = accelerateOrShorten(r, cpx);
 
@@ -445,7 +459,8 @@ option<Proof> Accelerator::run() {
     bool changed = false;
     std::set<TransIdx> toAdd;
     for (auto it = resultingRules.begin(); it != resultingRules.end();) {
-        const Rule r = its.getRule(*it);
+        const auto rSnapshot = its.getRule(*it);
+        const Rule &r = rSnapshot.get();
         const BoolExpr simplified = Z3::simplify(r.getGuard(), its);
         if (r.getGuard() != simplified) {
             const Rule &newR = r.withGuard(simplified);
@@ -486,6 +501,7 @@ option<Proof> Accelerator::run() {
 // #######################
 
 option<Proof> Accelerator::accelerateSimpleLoops(ITSProblem &its, LocationIdx loc, std::set<TransIdx> &resultingRules) {
+    SmtCallSite site(SmtCallSite::Acceleration);
     if (its.getSimpleLoopsAt(loc).empty()) {
         return {};
     }
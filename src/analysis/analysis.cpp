@@ -29,6 +29,17 @@
 #include "../accelerate/accelerator.hpp"
 #include "../its/export.hpp"
 #include "../smt/yices/yices.hpp"
+#include "../smt/z3/z3.hpp"
+#include "../smt/solverpool.hpp"
+#include "../smt/resultcache.hpp"
+#include "../smt/racingsolver.hpp"
+#include "../smt/linearpresolver.hpp"
+#include "../smt/smtcallsite.hpp"
+#include "../smt/smtstatistics.hpp"
+#include "../smt/modelcache.hpp"
+#include "../util/watchdog.hpp"
+#include "../util/budget.hpp"
+#include "../expr/dnfcursor.hpp"
 
 #include <future>
 
@@ -221,6 +232,7 @@ void Analysis::run() {
     } else {
         simp.wait();
     }
+    Budget::startPhase(Budget::Finalize);
     auto finalize = std::async([this, res]{this->finalize(*res);});
     if (Timeout::enabled()) {
         std::chrono::seconds remaining = Timeout::remainingHard();
@@ -238,25 +250,36 @@ void Analysis::run() {
     // WST style proof output
     cout << res->getCpx().toWstString() << std::endl;
     proof->print();
+    if (Config::Output::Statistics) {
+        SmtStatistics::printStatistics(std::cerr);
+        SolverPool::printStatistics(std::cerr);
+        ResultCache::printStatistics(std::cerr);
+        LinearPresolver::printStatistics(std::cerr);
+        ModelCache::printStatistics(std::cerr);
+        Watchdog::printStatistics(std::cerr);
+        Budget::printStatistics(std::cerr);
+        Z3::printStatistics(std::cerr);
+        RacingSolver::printStatistics(std::cerr);
+    }
 
     delete res;
     delete proof;
 
-    Yices::exit();
-
     bool simpDone = simp.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     bool finalizeDone = finalize.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
-    // propagate exceptions
-    if (simpDone) {
-        simp.get();
-    }
-    if (finalizeDone) {
-        finalize.get();
-    }
     if (!simpDone || !finalizeDone) {
         std::cerr << "some tasks are still running, calling std::terminate" << std::endl;
         std::terminate();
     }
+    // joins the threads, which destroys their pooled solvers
+    simp.wait();
+    finalize.wait();
+    SolverPool::clear();
+    Yices::exit();
+
+    // propagate exceptions
+    simp.get();
+    finalize.get();
 }
 
 // ############################
@@ -279,7 +302,8 @@ option<Proof> Analysis::ensureNonnegativeCosts() {
     std::vector<TransIdx> del;
     std::vector<Rule> add;
     for (TransIdx trans : its.getAllTransitions()) {
-        const Rule rule = its.getRule(trans);
+        const auto ruleSnapshot = its.getRule(trans);
+        const Rule &rule = ruleSnapshot.get();
         // Add the constraint unless it is trivial (e.g. if the cost is 1).
         Rel costConstraint = rule.getCost() >= 0;
         if (!costConstraint.isTriviallyTrue()) {
@@ -298,11 +322,18 @@ option<Proof> Analysis::ensureNonnegativeCosts() {
 
 
 bool Analysis::removeUnsatRules() {
+    SmtCallSite site(SmtCallSite::Pruning);
     bool changed = false;
 
-    for (TransIdx rule : its.getAllTransitions()) {
-        if (Smt::check(its.getRule(rule).getGuard(), its) == Smt::Unsat) {
-            its.removeRule(rule);
+    const auto rules = its.getAllTransitions();
+    std::vector<BoolExpr> guards;
+    for (TransIdx rule : rules) {
+        guards.push_back(its.getRule(rule)->getGuard());
+    }
+    const std::vector<Smt::Result> &sat = Smt::check(guards, its);
+    for (unsigned int i = 0; i < rules.size(); ++i) {
+        if (sat[i] == Smt::Unsat) {
+            its.removeRule(rules[i]);
             changed = true;
         }
     }
@@ -317,7 +348,8 @@ option<Proof> Analysis::preprocessRules() {
     std::vector<Rule> add;
     // update/guard preprocessing
     for (TransIdx idx : its.getAllTransitions()) {
-        const Rule rule = its.getRule(idx);
+        const auto ruleSnapshot = its.getRule(idx);
+        const Rule &rule = ruleSnapshot.get();
         const option<Rule> newRule = Preprocess::preprocessRule(its, rule);
         if (newRule) {
             del.push_back(idx);
@@ -390,11 +422,22 @@ bool Analysis::pruneRules() {
 
 void Analysis::checkConstantComplexity(RuntimeResult &res, Proof &proof) const {
 
-    for (TransIdx idx : its.getTransitionsFrom(its.getInitialLocation())) {
-        const Rule rule = its.getRule(idx);
-        BoolExpr guard = rule.getGuard() & (rule.getCost() >= 1);
+    const auto rules = its.getTransitionsFrom(its.getInitialLocation());
+    const std::vector<TransIdx> initial(rules.begin(), rules.end());
+    std::vector<BoolExpr> guards;
+    for (TransIdx idx : initial) {
+        const auto ruleSnapshot = its.getRule(idx);
+        const Rule &rule = ruleSnapshot.get();
+        guards.push_back(rule.getGuard() & (rule.getCost() >= 1));
+    }
+    const std::vector<Smt::Result> &sat = Smt::check(guards, its);
+
+    for (unsigned int i = 0; i < initial.size(); ++i) {
+        TransIdx idx = initial[i];
+        const auto ruleSnapshot = its.getRule(idx);
+        const Rule &rule = ruleSnapshot.get();
 
-        if (Smt::check(guard, its) == Smt::Sat) {
+        if (sat[i] == Smt::Sat) {
             proof.newline();
             proof.result("The following rule witnesses the lower bound Omega(1):");
             stringstream s;
@@ -409,7 +452,8 @@ void Analysis::checkConstantComplexity(RuntimeResult &res, Proof &proof) const {
 void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
     if (Config::Analysis::nonTermination()) {
         for (TransIdx i: rules) {
-            const Rule r = its.getRule(i);
+            const auto rSnapshot = its.getRule(i);
+            const Rule &r = rSnapshot.get();
             if (r.getCost().isNontermSymbol() && Smt::check(r.getGuard(), its) == Smt::Sat) {
                 res.update(r.getGuard(), Expr::NontermSymbol, Expr::NontermSymbol, Complexity::Nonterm);
                 Proof proof;
@@ -431,10 +475,10 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
         // rules without temporary variables (sorted by their degree) last
         // if rules are equal wrt. the criteria above, prefer those with less constraints in the guard
         auto comp = [this, isTempVar](const TransIdx &fst, const TransIdx &snd) {
-            Rule fstRule = its.getRule(fst);
-            Rule sndRule = its.getRule(snd);
-            Expr fstCpxExp = fstRule.getCost().expand();
-            Expr sndCpxExp = sndRule.getCost().expand();
+            const auto fstRule = its.getRule(fst);
+            const auto sndRule = its.getRule(snd);
+            Expr fstCpxExp = fstRule->getCost().expand();
+            Expr sndCpxExp = sndRule->getCost().expand();
             if (!fstCpxExp.equals(sndCpxExp)) {
                 if (fstCpxExp.isNontermSymbol()) return true;
                 if (sndCpxExp.isNontermSymbol()) return false;
@@ -451,15 +495,16 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
                 if (fstCpx > sndCpx) return true;
                 if (fstCpx < sndCpx) return false;
             }
-            unsigned long fstGuardSize = fstRule.getGuard()->size();
-            unsigned long sndGuardSize = sndRule.getGuard()->size();
+            unsigned long fstGuardSize = fstRule->getGuard()->size();
+            unsigned long sndGuardSize = sndRule->getGuard()->size();
             return fstGuardSize < sndGuardSize;
         };
 
         sort(todo.begin(), todo.end(), comp);
 
-        for (TransIdx ruleIdx : todo) {
-            Rule rule = its.getRule(ruleIdx);
+        for (unsigned int i = 0; i < todo.size(); ++i) {
+            TransIdx ruleIdx = todo[i];
+            Rule rule = *its.getRule(ruleIdx);
             Proof proof;
 
             // getComplexity() is not sound, but gives an upperbound, so we can avoid useless asymptotic checks.
@@ -487,7 +532,7 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
 
             option<AsymptoticBound::Result> checkRes;
             bool isPolynomial = rule.getCost().isPoly() && !rule.getCost().isNontermSymbol() && rule.getGuard()->isPolynomial();
-            unsigned int timeout = Timeout::soft() ? Config::Smt::LimitTimeoutFinalFast : Config::Smt::LimitTimeoutFinal;
+            unsigned int timeout = Budget::timeout(Budget::LimitFinal, todo.size() - i);
             if (isPolynomial && Config::Limit::PolyStrategy->smtEnabled()) {
                 checkRes = AsymptoticBound::determineComplexityViaSMT(
                             its,
@@ -512,15 +557,17 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
             }
 
             if ((!checkRes || checkRes->cpx == Complexity::Unknown) && Config::Limit::PolyStrategy->calculusEnabled()) {
-                std::vector<Guard> toCheck = rule.getGuard()->dnf();
-                if (toCheck.empty()) {
-                    // guard == True
-                    toCheck.push_back({});
-                }
-                for (const Guard &guard: toCheck) {
+                // the upper bound from above, no conjunction of the guard can yield a better result
+                Complexity maxCpx = hasTempVar ? Complexity::Unbounded : rule.getCost().toComplexity();
+                DnfCursor dnf(rule.getGuard(), its);
+                while (res.getCpx() < maxCpx) {
+                    const option<Guard> &guard = dnf.next();
+                    if (!guard) {
+                        break;
+                    }
                     checkRes = AsymptoticBound::determineComplexity(
                                 its,
-                                guard,
+                                guard.get(),
                                 rule.getCost(),
                                 true,
                                 res.getCpx(),
@@ -539,6 +586,14 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
                         }
                     }
                 }
+                // the remaining conjunctions might have yielded a better bound
+                if (dnf.budgetExhausted() && res.getCpx() < maxCpx) {
+                    Proof incomplete;
+                    incomplete.append(stringstream() << "Stopped enumerating the DNF of the guard of rule " << ruleIdx
+                                      << " after " << Config::Limit::DnfBudget << " steps, so its bound may not be tight.");
+                    incomplete.newline();
+                    res.concat(incomplete);
+                }
             }
         }
     }
@@ -548,7 +603,7 @@ void Analysis::getMaxRuntimeOf(const set<TransIdx> &rules, RuntimeResult &res) {
 
 void Analysis::getMaxRuntime(RuntimeResult &res) {
     auto rules = its.getTransitionsFrom(its.getInitialLocation());
-    getMaxRuntimeOf(rules, res);
+    getMaxRuntimeOf(rules.get(), res);
 }
 
 
@@ -568,7 +623,7 @@ static bool removeConstantPathsImpl(ITSProblem &its, LocationIdx curr, set<Locat
         // In this case, all constant rules leading to next are not interesting and can be removed.
         if (removeConstantPathsImpl(its, next, visited)) {
             for (TransIdx rule : its.getTransitionsFromTo(curr, next)) {
-                if (its.getRule(rule).getCost().toComplexity() <= Complexity::Const) {
+                if (its.getRule(rule)->getCost().toComplexity() <= Complexity::Const) {
                     its.removeRule(rule);
                 }
             }
@@ -593,7 +648,7 @@ void Analysis::getMaxPartialResult(RuntimeResult &res) {
     while (true) {
 
         // check runtime of all rules from the start state
-        getMaxRuntimeOf(its.getTransitionsFrom(initial), res);
+        getMaxRuntimeOf(its.getTransitionsFrom(initial).get(), res);
 
         // handle special cases to ensure termination in time
         if (res.getCpx() >= Complexity::Unbounded) return;
@@ -604,10 +659,11 @@ void Analysis::getMaxPartialResult(RuntimeResult &res) {
 
         for (LocationIdx succ : succs) {
             for (TransIdx first : its.getTransitionsFromTo(initial,succ)) {
-                const Rule firstRule = its.getRule(first);
+                const auto firstRuleSnapshot = its.getRule(first);
+                const Rule &firstRule = firstRuleSnapshot.get();
                 std::vector<Rule> replacement;
                 for (TransIdx second : its.getTransitionsFrom(succ)) {
-                    auto chained = Chaining::chainRules(its, firstRule, its.getRule(second));
+                    auto chained = Chaining::chainRules(its, firstRule, *its.getRule(second));
                     if (chained) {
                         replacement.push_back(chained.get());
                     }
@@ -18,6 +18,9 @@
 #include "chain.hpp"
 
 #include "../smt/smt.hpp"
+#include "../smt/solverpool.hpp"
+#include "../smt/smtcallsite.hpp"
+#include "../smt/modelcache.hpp"
 #include "../config.hpp"
 #include "../expr/boolexpr.hpp"
 
@@ -32,6 +35,7 @@ using namespace std;
  * Helper for chainRules. Checks if the given (chained) guard is satisfiable.
  */
 static bool checkSatisfiability(const BoolExpr newGuard, VariableManager &varMan) {
+    SmtCallSite site(SmtCallSite::Chaining);
     auto smtRes = Smt::check(newGuard, varMan);
 
     // If we still get "unknown", we interpret it as "sat", so we prefer to chain if unsure.
@@ -196,3 +200,54 @@ option<LinearRule> Chaining::chainRules(VarMan &varMan, const LinearRule &first,
 {
     return chainLinearRules(varMan, first.toLinear(), second.toLinear(), checkSat);
 }
+
+vector<option<Rule>> Chaining::chainRules(VarMan &varMan, const Rule &first, const vector<Snapshot<Rule>> &seconds) {
+    SmtCallSite site(SmtCallSite::Chaining);
+    vector<option<Rule>> res;
+    if (!Config::Chain::CheckSat) {
+        for (const auto &second: seconds) {
+            res.push_back(chainRules(varMan, first, *second, false));
+        }
+        return res;
+    }
+
+    // The constraints that chaining with second adds to first's guard,
+    // i.e., second's guard instantiated with the update of each rhs of first that leads to second
+    vector<BoolExpr> extensions;
+    for (const auto &snapshot: seconds) {
+        const Rule &second = snapshot.get();
+        vector<BoolExpr> constraints;
+        for (unsigned int i = 0; i < first.rhsCount(); ++i) {
+            if (first.getRhsLoc(i) == second.getLhsLoc()) {
+                constraints.push_back(second.getGuard()->subs(first.getUpdate(i)));
+            }
+        }
+        extensions.push_back(buildAnd(constraints));
+    }
+
+    vector<BoolExpr> all(extensions);
+    all.push_back(first.getGuard());
+    Smt::Logic logic = Smt::chooseLogic(all);
+    SolverPool::Lease solver = SolverPool::acquire(logic, varMan);
+    solver->add(first.getGuard());
+    for (unsigned int i = 0; i < seconds.size(); ++i) {
+        bool sat = ModelCache::isSat(first.getGuard() & extensions[i], varMan);
+        if (!sat) {
+            solver->push();
+            solver->add(extensions[i]);
+            // as in checkSatisfiability, "unknown" is interpreted as "sat"
+            Smt::Result smtRes = solver->check();
+            sat = smtRes != Smt::Unsat;
+            if (smtRes == Smt::Sat && logic == Smt::QF_LA) {
+                ModelCache::add(solver->model(), varMan);
+            }
+            solver->pop();
+        }
+        if (sat) {
+            res.push_back(chainRules(varMan, first, *seconds[i], false));
+        } else {
+            res.push_back({});
+        }
+    }
+    return res;
+}
@@ -21,6 +21,7 @@
 #include "../its/rule.hpp"
 #include "../its/variablemanager.hpp"
 #include "../util/option.hpp"
+#include "../util/snapshot.hpp"
 
 
 namespace Chaining {
@@ -36,6 +37,14 @@ namespace Chaining {
      * The implementation is much simpler, but semantically equivalent to chainRules.
      */
     option<LinearRule> chainRules(VarMan &varMan, const LinearRule &first, const LinearRule &second, bool checkSat = true);
+
+    /**
+     * Chains the first rule with each of the given rules, equivalent to calling chainRules for each of them.
+     * However, the first rule's guard is only asserted once and the satisfiability of the chained guards
+     * is checked incrementally (using push/pop) with a single solver.
+     * @return The resulting rules (in the same order as seconds), none for rules that cannot be chained.
+     */
+    std::vector<option<Rule>> chainRules(VarMan &varMan, const Rule &first, const std::vector<Snapshot<Rule>> &seconds);
 }
 
 #endif // CHAIN_H
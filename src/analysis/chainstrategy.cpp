@@ -48,10 +48,14 @@ static Proof eliminateLocationByChaining(ITSProblem &its, LocationIdx loc,
     Proof proof;
     proof.headline("Eliminating location " + its.getPrintableLocationName(loc) + " by chaining:");
 
+    // the outgoing guards are instantiated with the update of every incoming rule
+    SubsMemo memo;
+
     // Chain all pairs of in- and outgoing rules
     for (TransIdx in : its.getTransitionsTo(loc)) {
         bool wasChainedWithAll = true;
-        const Rule inRule = its.getRule(in);
+        const auto inRuleSnapshot = its.getRule(in);
+        const Rule &inRule = inRuleSnapshot.get();
 
         // We usually require that loc doesn't have any self-loops (since we would destroy the self-loop by chaining).
         // E.g. chaining f -> g, g -> g would result in f -> g without the self-loop.
@@ -61,9 +65,16 @@ static Proof eliminateLocationByChaining(ITSProblem &its, LocationIdx loc,
         // since the resulting chained rule would in the end be deleted (together with loc) anyway.
         if (inRule.getLhsLoc() == loc) continue;
 
+        // Chain with all outgoing rules at once, so that the incoming rule's guard is only asserted once
+        vector<Snapshot<Rule>> outRules;
         for (TransIdx out : its.getTransitionsFrom(loc)) {
-            const Rule outRule = its.getRule(out);
-            auto optRule = Chaining::chainRules(its, inRule, outRule);
+            outRules.push_back(its.getRule(out));
+        }
+        const vector<option<Rule>> &chained = Chaining::chainRules(its, inRule, outRules);
+
+        for (unsigned int i = 0; i < outRules.size(); ++i) {
+            const Rule &outRule = outRules[i].get();
+            auto optRule = chained[i];
             if (optRule) {
                 // If we allow self loops at loc, then chained rules may still lead to loc,
                 // e.g. if h -> f and f -> f,g are chained to h -> f,g (where f is loc).
@@ -103,7 +114,8 @@ static Proof eliminateLocationByChaining(ITSProblem &its, LocationIdx loc,
     if (keepUnchainable && !keepRules.empty()) {
         LocationIdx dummyLoc = its.addLocation();
         for (TransIdx trans : keepRules) {
-            const Rule oldRule = its.getRule(trans);
+            const auto oldRuleSnapshot = its.getRule(trans);
+            const Rule &oldRule = oldRuleSnapshot.get();
             auto newRule = oldRule.stripRhsLocation(loc);
             if (newRule) {
                 // In case of nonlinear rules, we can simply delete all rhss leading to loc, but keep the other ones
@@ -324,18 +336,21 @@ option<Proof> Chaining::chainAcceleratedRules(ITSProblem &its, const set<TransId
     // so we would use chained rules from the first visit as incoming rules for the second visit.
     set<LocationIdx> nodes;
     for (TransIdx accel : acceleratedRules) {
-        nodes.insert(its.getRule(accel).getLhsLoc());
+        nodes.insert(its.getRule(accel)->getLhsLoc());
     }
 
     for (LocationIdx node : nodes) {
         // We only query the incoming transitions once, before adding new rules starting at node
-        set<TransIdx> incomingTransitions = its.getTransitionsTo(node);
+        const auto incomingTransitions = its.getTransitionsTo(node);
 
+        // the guards of the accelerated rules are instantiated with the update of every incoming rule
+        SubsMemo memo;
         std::set<TransIdx> deleted;
         for (TransIdx accel : its.getTransitionsFrom(node)) {
             // Only chain accelerated rules
             if (acceleratedRules.count(accel) == 0) continue;
-            const Rule accelRule = its.getRule(accel);
+            const auto accelRuleSnapshot = its.getRule(accel);
+            const Rule &accelRule = accelRuleSnapshot.get();
 
             deleted.insert(accel);
             std::vector<Rule> replacement;
@@ -346,7 +361,8 @@ option<Proof> Chaining::chainAcceleratedRules(ITSProblem &its, const set<TransId
 
                 // Do not chain with incoming loops that are themselves self-loops at node
                 // (no matter if they are simple or not)
-                const Rule incomingRule = its.getRule(incoming);
+                const auto incomingRuleSnapshot = its.getRule(incoming);
+                const Rule &incomingRule = incomingRuleSnapshot.get();
                 if (incomingRule.getLhsLoc() == node) continue;
 
                 auto optRule = Chaining::chainRules(its, incomingRule, accelRule);
@@ -155,17 +155,18 @@ option<Rule> Preprocess::eliminateTempVars(VarMan &varMan, const Rule &rule, boo
     Rule oldRule = rule;
     option<Rule> newRule;
 
+    // variables in the rhss of the update of oldRule, must be recomputed whenever oldRule changes
+    VarIdSet varsInUpdate;
+
     //declare helper lambdas to filter variables, to be passed as arguments
     auto isTemp = [&](const Var &sym) {
         return varMan.isTempVar(sym);
     };
     auto isTempInUpdate = [&](const Var &sym) {
-        VarSet varsInUpdate = collectVarsInUpdateRhs(oldRule);
-        return isTemp(sym) && varsInUpdate.count(sym) > 0;
+        return isTemp(sym) && varsInUpdate.contains(varMan.getId(sym));
     };
     auto isTempOnlyInGuard = [&](const Var &sym) {
-        VarSet varsInUpdate = collectVarsInUpdateRhs(oldRule);
-        return isTemp(sym) && varsInUpdate.count(sym) == 0 && !rule.getCost().has(sym);
+        return isTemp(sym) && !varsInUpdate.contains(varMan.getId(sym)) && !rule.getCost().has(sym);
     };
 
     //equalities allow easy propagation, thus transform x <= y, x >= y into x == y
@@ -175,6 +176,7 @@ option<Rule> Preprocess::eliminateTempVars(VarMan &varMan, const Rule &rule, boo
         changed = true;
     }
     //try to remove temp variables from the update by equality propagation (they are removed from guard and update)
+    varsInUpdate = varMan.getIds(collectVarsInUpdateRhs(oldRule));
     newRule = GuardToolbox::propagateEqualities(varMan, oldRule, GuardToolbox::ResultMapsToInt, isTempInUpdate);
     if (newRule) {
         oldRule = newRule.get();
@@ -198,6 +200,7 @@ option<Rule> Preprocess::eliminateTempVars(VarMan &varMan, const Rule &rule, boo
 
     //now eliminate a <= x and replace a <= x, x <= b by a <= b for all free variables x where this is sound
     //(not sound if x appears in update or cost, since we then need the value of x)
+    varsInUpdate = varMan.getIds(collectVarsInUpdateRhs(oldRule));
     newRule = GuardToolbox::eliminateByTransitiveClosure(oldRule, true, isTempOnlyInGuard);
     if (newRule) {
         oldRule = newRule.get();
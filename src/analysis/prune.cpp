@@ -21,6 +21,7 @@
 #include "../its/itsproblem.hpp"
 #include "../expr/boolexpr.hpp"
 #include "../smt/smt.hpp"
+#include "../smt/smtcallsite.hpp"
 #include "../asymptotic/asymptoticbound.hpp"
 #include "../its/export.hpp"
 
@@ -30,6 +31,7 @@
 using namespace std;
 
 bool Pruning::pruneParallelRules(ITSProblem &its) {
+    SmtCallSite site(SmtCallSite::Pruning);
     // To compare rules, we store a tuple of the rule's index, its complexity and the number of inftyVars
     // (see ComplexityResult for the latter). We first compare the complexity, then the number of inftyVars.
     typedef tuple<TransIdx,Complexity,int> TransCpx;
@@ -56,7 +58,8 @@ bool Pruning::pruneParallelRules(ITSProblem &its) {
                     unsigned long idx = (i % 2 == 0) ? i/2 : parallel.size()-1-i/2;
 
                     TransIdx ruleIdx = parallel[idx];
-                    const Rule rule = its.getRule(parallel[idx]);
+                    const auto ruleSnapshot = its.getRule(parallel[idx]);
+                    const Rule &rule = ruleSnapshot.get();
 
                     // compute the complexity (real check using asymptotic bounds) and store in priority queue
                     Complexity cpx;
@@ -84,7 +87,7 @@ bool Pruning::pruneParallelRules(ITSProblem &its) {
                 // Check if there is an dummy rule (if there is, we want to keep an empty rule)
                 bool hasDummy = false;
                 for (TransIdx rule : parallel) {
-                    if (its.getRule(rule).isDummyRule()) {
+                    if (its.getRule(rule)->isDummyRule()) {
                         hasDummy = true;
                         break;
                     }
@@ -95,7 +98,8 @@ bool Pruning::pruneParallelRules(ITSProblem &its) {
                 std::vector<TransIdx> toRemove;
                 std::vector<Rule> toAdd;
                 for (TransIdx rule : parallel) {
-                    const Rule r = its.getRule(rule);
+                    const auto rSnapshot = its.getRule(rule);
+                    const Rule &r = rSnapshot.get();
                     if ((Config::Analysis::complexity() || !r.getCost().isNontermSymbol()) && keep.count(rule) == 0) {
                         toRemove.push_back(rule);
                         auto optRule = r.stripRhsLocation(node);
@@ -137,7 +141,8 @@ static bool removeIrrelevantLeafs(ITSProblem &its, LocationIdx node, set<Locatio
         // If next is (now) a leaf, rules leading to next are candidates for removal
         if (isLeaf(next)) {
             for (TransIdx ruleIdx : its.getTransitionsFromTo(node, next)) {
-                const Rule rule = its.getRule(ruleIdx);
+                const auto ruleSnapshot = its.getRule(ruleIdx);
+                const Rule &rule = ruleSnapshot.get();
 
                 // only remove irrelevant rules
                 const Complexity &c = rule.getCost().toComplexity();
@@ -192,7 +197,8 @@ bool Pruning::removeLeafsAndUnreachable(ITSProblem &its) {
  * @return true iff the ITS was modified
  */
 static bool partialDeletion(ITSProblem &its, TransIdx ruleIdx, LocationIdx loc) {
-    const Rule rule = its.getRule(ruleIdx);
+    const auto ruleSnapshot = its.getRule(ruleIdx);
+    const Rule &rule = ruleSnapshot.get();
     assert(its.getTransitionTargets(ruleIdx).count(loc) > 0); // should only call this if we can delete something
 
     // If the rule only has one rhs, we do not change it (this ensures termination of the overall algorithm)
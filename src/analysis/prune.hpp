@@ -21,6 +21,7 @@
 #include "../its/types.hpp"
 #include "../its/itsproblem.hpp"
 #include "../smt/smt.hpp"
+#include "../smt/smtcallsite.hpp"
 
 class Rule;
 class ITSProblem;
@@ -42,8 +43,10 @@ namespace Pruning {
                 TransIdx idxA = *i;
                 TransIdx idxB = *j;
 
-                const Rule &ruleA = its.getRule(idxA);
-                const Rule &ruleB = its.getRule(idxB);
+                const auto ruleASnapshot = its.getRule(idxA);
+                const Rule &ruleA = ruleASnapshot.get();
+                const auto ruleBSnapshot = its.getRule(idxB);
+                const Rule &ruleB = ruleBSnapshot.get();
 
                 // if rules are identical up to cost, keep the one with the higher cost
                 if (ruleA.approxEqual(ruleB, compareRhss)) {
@@ -66,16 +69,23 @@ namespace Pruning {
 
     /**
      * Removes all rules within the given list/set/... whose guard is found to be unsatisfiable.
-     * This involves a single z3 query for every transition.
+     * All guards are checked in one batch (see Smt::check).
      * @return true iff the ITS was modified (i.e., an unsat rule got deleted)
      */
     template <typename Container>
     bool removeUnsatRules(ITSProblem &its, const Container &trans) {
+        SmtCallSite site(SmtCallSite::Pruning);
         bool changed = false;
 
-        for (TransIdx rule : trans) {
-            if (Smt::check(its.getRule(rule).getGuard(), its) == Smt::Unsat) {
-                its.removeRule(rule);
+        const std::vector<TransIdx> rules(trans.begin(), trans.end());
+        std::vector<BoolExpr> guards;
+        for (TransIdx rule : rules) {
+            guards.push_back(its.getRule(rule)->getGuard());
+        }
+        const std::vector<Smt::Result> &sat = Smt::check(guards, its);
+        for (unsigned int i = 0; i < rules.size(); ++i) {
+            if (sat[i] == Smt::Unsat) {
+                its.removeRule(rules[i]);
                 changed = true;
             }
         }
@@ -1,5 +1,6 @@
 #include "rankingfunctionfinder.hpp"
 #include "../smt/yices/yices.hpp"
+#include "../smt/solverpool.hpp"
 #include "../util/proof.hpp"
 #include "../accelerate/accelerationCalculus/rankingfunctionproblem.hpp"
 #include "../analysis/preprocess.hpp"
@@ -9,7 +10,7 @@ void RankingFunctionFinder::run(ITSProblem &its) {
     for (auto loc: its.getLocations()) {
         for (auto idx: its.getSimpleLoopsAt(loc)) {
             Proof preProof;
-            auto rule = its.getRule(idx);
+            Rule rule = *its.getRule(idx);
             const option<Rule> newRule = Preprocess::preprocessRule(its, rule);
             if (newRule) {
                 preProof.ruleTransformationProof(rule, "preprocessing", newRule.get(), its);
@@ -31,5 +32,6 @@ void RankingFunctionFinder::run(ITSProblem &its) {
            }
         }
     }
+    SolverPool::clear();
     Yices::exit();
 }
@@ -1,5 +1,6 @@
 #include "recurrentsetfinder.hpp"
 #include "../smt/yices/yices.hpp"
+#include "../smt/solverpool.hpp"
 #include "../util/proof.hpp"
 #include "../accelerate/accelerationCalculus/accelerationproblem.hpp"
 #include "../analysis/preprocess.hpp"
@@ -10,7 +11,7 @@ void RecurrentSetFinder::run(ITSProblem &its) {
     for (auto loc: its.getLocations()) {
         for (auto idx: its.getSimpleLoopsAt(loc)) {
             Proof preProof;
-            auto rule = its.getRule(idx);
+            Rule rule = *its.getRule(idx);
             const option<Rule> newRule = Preprocess::preprocessRule(its, rule);
             if (newRule) {
                 preProof.ruleTransformationProof(rule, "preprocessing", newRule.get(), its);
@@ -53,5 +54,6 @@ void RecurrentSetFinder::run(ITSProblem &its) {
 //            }
 //        }
 //    }
+    SolverPool::clear();
     Yices::exit();
 }
@@ -10,6 +10,7 @@
 
 #include "../smt/smt.hpp"
 #include "../smt/smtfactory.hpp"
+#include "../smt/smtcallsite.hpp"
 
 #include "limitsmt.hpp"
 #include "inftyexpression.hpp"
@@ -770,6 +771,7 @@ AsymptoticBound::Result AsymptoticBound::determineComplexity(VarMan &varMan,
                                                              bool finalCheck,
                                                              const Complexity &currentRes,
                                                              unsigned int timeout) {
+    SmtCallSite site(SmtCallSite::Limit);
 
     // Expand the cost to make it easier to analyze
     Expr expandedCost = cost.expand();
@@ -840,6 +842,7 @@ AsymptoticBound::Result AsymptoticBound:: determineComplexityViaSMT(VarMan &varM
                                                                     bool finalCheck,
                                                                     Complexity currentRes,
                                                                     unsigned int timeout) {
+    SmtCallSite site(SmtCallSite::Limit);
     Expr expandedCost = cost.expand();
     // Handle nontermination. It suffices to check that the guard is satisfiable
     if (expandedCost.isNontermSymbol()) {
@@ -878,6 +881,7 @@ AsymptoticBound::Result AsymptoticBound:: determineComplexityViaSMT(VarMan &varM
                                                                     bool finalCheck,
                                                                     Complexity currentRes,
                                                                     unsigned int timeout) {
+    SmtCallSite site(SmtCallSite::Limit);
     Expr expandedCost = cost.expand();
     // Handle nontermination. It suffices to check that the guard is satisfiable
     if (expandedCost.isNontermSymbol()) {
@@ -10,6 +10,7 @@
 #include "inftyexpression.hpp"
 #include "limitproblem.hpp"
 #include "../util/proof.hpp"
+#include "../util/budget.hpp"
 
 
 class AsymptoticBound {
@@ -108,21 +109,21 @@ public:
                                       const Expr &cost,
                                       bool finalCheck = false,
                                       const Complexity &currentRes = Complexity::Const,
-                                      unsigned int timeout = Config::Smt::LimitTimeout);
+                                      unsigned int timeout = Budget::timeout(Budget::Limit));
 
     static Result determineComplexityViaSMT(VarMan &varMan,
                                             const Guard &guard,
                                             const Expr &cost,
                                             bool finalCheck = false,
                                             Complexity currentRes = Complexity::Const,
-                                            unsigned int timeout = Config::Smt::LimitTimeout);
+                                            unsigned int timeout = Budget::timeout(Budget::Limit));
 
     static Result determineComplexityViaSMT(VarMan &varMan,
                                             const BoolExpr guard,
                                             const Expr &cost,
                                             bool finalCheck = false,
                                             Complexity currentRes = Complexity::Const,
-                                            unsigned int timeout = Config::Smt::LimitTimeout);
+                                            unsigned int timeout = Budget::timeout(Budget::Limit));
 
 };
 
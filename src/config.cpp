@@ -34,6 +34,9 @@ namespace Config {
     namespace Output {
         // Whether to enable colors in the proof output
         bool Colors = true;
+
+        // Whether to print statistics about the SMT layer (to stderr) after the analysis
+        bool Statistics = false;
     }
 
     namespace Color {
@@ -67,11 +70,49 @@ namespace Config {
         const unsigned LimitTimeoutFinalFast = 500u;
         const unsigned SimpTimeout = 200u;
 
+        // If a global timeout is set, the above timeouts are adapted to the remaining time (see Budget):
+        // A query gets at most 1/BudgetShare of the remaining time (but at least MinTimeout),
+        // and final limit problems may get up to MaxTimeoutStretch times their timeout if there is time left.
+        const unsigned BudgetShare = 4u;
+        const unsigned MinTimeout = 50u;
+        const unsigned MaxTimeoutStretch = 4u;
+
+        // The maximal number of satisfiability results that are cached (least recently used ones are evicted)
+        const unsigned ResultCacheSize = 10000u;
+
+        // The maximal number of simplified formulas that are cached (least recently used ones are evicted)
+        const unsigned SimpCacheSize = 1000u;
+
+        // Whether to run yices and z3 concurrently for non-linear queries (the first definitive answer wins).
+        // Reduces the latency of hard queries, but occupies a second core.
+        bool RacePortfolio = false;
+
+        // The maximal number of converted terms (and literals) that each solver keeps,
+        // to avoid converting the same GiNaC expressions again and again
+        const unsigned ConversionCacheSize = 10000u;
+
+        // Limits for deciding small linear conjunctions without calling an SMT solver
+        // (maximal number of literals / variables of the query and of constraints during Fourier-Motzkin elimination)
+        const unsigned PresolverMaxLits = 12u;
+        const unsigned PresolverMaxVars = 6u;
+        const unsigned PresolverMaxConstraints = 200u;
+
+        // The number of recent models (per thread) that are evaluated before calling a solver (see ModelCache).
+        const unsigned ModelCacheSize = 8u;
+
+        // If non-empty, all SMT queries are appended to this file in SMT-LIB2 format (see SmtCapture).
+        std::string CaptureFile = "";
+
         // The largest k for which x^k is rewritten to x*x*...*x (k times).
         // z3 does not like powers, so writing x*x*...*x can sometimes help.
         const unsigned MaxExponentWithoutPow = 5;
     }
 
+    namespace Expand {
+        // Number of expanded terms that are cached per thread by Expr::expand
+        const unsigned CacheSize = 4096u;
+    }
+
     // Loop acceleration technique
     namespace LoopAccel {
         // If KeepTempVarForIterationCount is false, then "k" is instantiated by its upper bounds.
@@ -116,6 +157,10 @@ namespace Config {
 
         // Discard a limit problem of size >= ProblemDiscardSize in a non-final check if z3 yields "unknown"
         const unsigned int ProblemDiscardSize = 10;
+
+        // Maximal number of SMT checks and conjunctions when enumerating the DNF of a guard for the limit calculus
+        // (conjunctions beyond the budget are not considered, which is reported in the proof)
+        const unsigned int DnfBudget = 64;
     }
 
     namespace Analysis {
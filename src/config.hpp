@@ -37,6 +37,7 @@ namespace Config {
     // Proof output
     namespace Output {
         extern bool Colors;
+        extern bool Statistics;
     }
 
     // Colors (Ansi color codes) for output
@@ -68,6 +69,23 @@ namespace Config {
         extern const unsigned LimitTimeoutFinalFast;
         extern const unsigned MaxExponentWithoutPow;
         extern const unsigned SimpTimeout;
+        extern const unsigned BudgetShare;
+        extern const unsigned MinTimeout;
+        extern const unsigned MaxTimeoutStretch;
+        extern const unsigned ResultCacheSize;
+        extern const unsigned SimpCacheSize;
+        extern bool RacePortfolio;
+        extern const unsigned ConversionCacheSize;
+        extern const unsigned PresolverMaxLits;
+        extern const unsigned PresolverMaxVars;
+        extern const unsigned PresolverMaxConstraints;
+        extern const unsigned ModelCacheSize;
+        extern std::string CaptureFile;
+    }
+
+    // Caching of expanded terms
+    namespace Expand {
+        extern const unsigned CacheSize;
     }
 
     // Loop acceleration technique
@@ -120,6 +138,7 @@ namespace Config {
 
         extern PolynomialLimitProblemStrategy* PolyStrategy;
         extern const unsigned int ProblemDiscardSize;
+        extern const unsigned int DnfBudget;
     }
 
     // Main algorithm
@@ -3,13 +3,98 @@
 #include <functional>
 #include <iostream>
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * The table of all live nodes, indexed by their hash.
+ * Nodes do not unregister themselves on destruction (which would require locking the table while other
+ * nodes are released), instead, entries of dead nodes are removed whenever the table has doubled in size.
+ * Comparing literals structurally may be costly, so the lock is only held while collecting the live nodes
+ * with the same hash, but not while comparing them.
+ */
+struct Interning {
+
+    typedef std::unordered_multimap<unsigned, std::weak_ptr<const BoolExpression>> Table;
+
+    static BoolExpr intern(const std::shared_ptr<BoolExpression> &fresh) {
+        // the nodes that have already been compared with fresh (keeping them alive, so that their addresses
+        // are not reused)
+        std::vector<BoolExpr> checked;
+        bool initialized = false;
+        std::unique_lock<std::mutex> lock(mutex());
+        while (true) {
+            const std::vector<BoolExpr> &candidates = collectCandidates(*fresh, checked);
+            if (candidates.empty() && initialized) {
+                break;
+            }
+            lock.unlock();
+            for (const BoolExpr &c: candidates) {
+                if (c->shallowEquals(*fresh)) {
+                    return c;
+                }
+                checked.push_back(c);
+            }
+            // outside of the lock, computing the attributes may be costly
+            if (!initialized) {
+                fresh->initAttributes();
+                initialized = true;
+            }
+            // another thread may have added the same node in the meantime
+            lock.lock();
+        }
+        Table &t = table();
+        if (t.size() >= sweepThreshold) {
+            for (auto it = t.begin(); it != t.end();) {
+                it = it->second.expired() ? t.erase(it) : std::next(it);
+            }
+            sweepThreshold = std::max<size_t>(MinSweepThreshold, 2 * t.size());
+        }
+        t.emplace(fresh->hashValue, fresh);
+        return fresh;
+    }
+
+private:
+
+    // the live nodes with the same hash as fresh that are not contained in checked (only compares addresses)
+    static std::vector<BoolExpr> collectCandidates(const BoolExpression &fresh, const std::vector<BoolExpr> &checked) {
+        std::vector<BoolExpr> res;
+        auto range = table().equal_range(fresh.hashValue);
+        for (auto it = range.first; it != range.second; ++it) {
+            const BoolExpr &existing = it->second.lock();
+            if (existing && std::find(checked.begin(), checked.end(), existing) == checked.end()) {
+                res.push_back(existing);
+            }
+        }
+        return res;
+    }
+
+    static const size_t MinSweepThreshold = 1024;
+    static size_t sweepThreshold;
+
+    // never destructed, as nodes may still be released during static destruction
+    static Table& table() {
+        static Table *t = new Table();
+        return *t;
+    }
+
+    static std::mutex& mutex() {
+        static std::mutex *m = new std::mutex();
+        return *m;
+    }
+
+};
+
+size_t Interning::sweepThreshold = Interning::MinSweepThreshold;
 
 BoolExpression::~BoolExpression() {}
 
-RelSet BoolExpression::lits() const {
-    RelSet res;
-    collectLits(res);
-    return res;
+unsigned BoolExpression::hash() const {
+    return hashValue;
+}
+
+const RelSet& BoolExpression::lits() const {
+    return *litSet;
 }
 
 Guard BoolExpression::conjunctionToGuard() const {
@@ -17,19 +102,177 @@ Guard BoolExpression::conjunctionToGuard() const {
     return Guard(lits.begin(), lits.end());
 }
 
-VarSet BoolExpression::vars() const {
-    VarSet res;
-    collectVars(res);
+const VarSet& BoolExpression::vars() const {
+    return *varSet;
+}
+
+void BoolExpression::collectLits(RelSet &res) const {
+    res.insert(litSet->begin(), litSet->end());
+}
+
+void BoolExpression::collectVars(VarSet &res) const {
+    res.insert(varSet->begin(), varSet->end());
+}
+
+bool BoolExpression::isLinear() const {
+    return linear;
+}
+
+bool BoolExpression::isPolynomial() const {
+    return polynomial;
+}
+
+size_t BoolExpression::size() const {
+    return nodeCount;
+}
+
+namespace {
+
+    struct SubsMemoState {
+        unsigned int scopes = 0;
+        // memoized results, grouped by the hash of the substitution
+        std::unordered_multimap<unsigned, std::pair<Subs, std::unordered_map<BoolExpr, BoolExpr>>> results;
+        // the substitution of the outermost running call of subs and its results
+        const Subs *current = nullptr;
+        std::unordered_map<BoolExpr, BoolExpr> *currentResults = nullptr;
+
+        std::unordered_map<BoolExpr, BoolExpr>& resultsFor(const Subs &subs) {
+            unsigned hash = subs.hash();
+            auto range = results.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second.first == subs) {
+                    return it->second.second;
+                }
+            }
+            return results.emplace(hash, std::make_pair(subs, std::unordered_map<BoolExpr, BoolExpr>()))->second.second;
+        }
+    };
+
+    thread_local SubsMemoState subsMemo;
+
+    // returns true iff subs maps some variable from vars to something else than itself
+    bool affects(const Subs &subs, const VarSet &vars) {
+        if (subs.size() <= vars.size()) {
+            for (const auto &p: subs) {
+                if (vars.count(p.first) > 0 && !p.second.equals(p.first)) {
+                    return true;
+                }
+            }
+        } else {
+            for (const Var &x: vars) {
+                auto it = subs.find(x);
+                if (it != subs.end() && !it->second.equals(x)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+}
+
+SubsMemo::SubsMemo() {
+    ++subsMemo.scopes;
+}
+
+SubsMemo::~SubsMemo() {
+    if (--subsMemo.scopes == 0) {
+        subsMemo.results.clear();
+    }
+}
+
+BoolExpr BoolExpression::subs(const Subs &subs) const {
+    // subformulas that do not contain substituted variables are shared with the result
+    if (!affects(subs, *varSet)) {
+        return shared_from_this();
+    }
+    SubsMemoState &memo = subsMemo;
+    if (memo.scopes == 0 || (memo.current && memo.current != &subs)) {
+        return _subs(subs);
+    }
+    bool outermost = !memo.current;
+    if (outermost) {
+        memo.current = &subs;
+        memo.currentResults = &memo.resultsFor(subs);
+    }
+    // forget the current substitution when the outermost call returns
+    struct Reset {
+        SubsMemoState &memo;
+        bool active;
+        ~Reset() {
+            if (active) {
+                memo.current = nullptr;
+            }
+        }
+    } reset{memo, outermost};
+    std::unordered_map<BoolExpr, BoolExpr> &results = *memo.currentResults;
+    const BoolExpr self = shared_from_this();
+    auto it = results.find(self);
+    if (it != results.end()) {
+        return it->second;
+    }
+    BoolExpr res = _subs(subs);
+    results.emplace(self, res);
     return res;
 }
 
+namespace {
+
+    // function-local, since formulas may be built during static initialization
+    const std::shared_ptr<const VarSet>& noVars() {
+        static const std::shared_ptr<const VarSet> res = std::make_shared<const VarSet>();
+        return res;
+    }
+
+    const std::shared_ptr<const RelSet>& noLits() {
+        static const std::shared_ptr<const RelSet> res = std::make_shared<const RelSet>();
+        return res;
+    }
+
+    /**
+     * Computes the union of the given sets of all children.
+     * If one child's set already contains all elements, it is shared instead of copied.
+     */
+    template <class Set>
+    std::shared_ptr<const Set> unite(const std::vector<std::shared_ptr<const Set>> &sets, const std::shared_ptr<const Set> &empty) {
+        if (sets.empty()) {
+            return empty;
+        }
+        auto largest = std::max_element(sets.begin(), sets.end(), [](const std::shared_ptr<const Set> &a, const std::shared_ptr<const Set> &b) {
+            return a->size() < b->size();
+        });
+        std::shared_ptr<Set> res;
+        for (const std::shared_ptr<const Set> &s: sets) {
+            if (s == *largest) {
+                continue;
+            }
+            for (const auto &x: *s) {
+                if (!res && (*largest)->count(x) > 0) {
+                    continue;
+                }
+                if (!res) {
+                    res = std::make_shared<Set>(**largest);
+                }
+                res->insert(x);
+            }
+        }
+        if (res) {
+            return res;
+        }
+        return *largest;
+    }
+
+}
+
 std::vector<Guard> BoolExpression::dnf() const {
     std::vector<Guard> res;
     dnf(res);
     return res;
 }
 
-BoolConst::BoolConst(int id): id(id) {}
+BoolConst::BoolConst(int id): id(id) {
+    hashValue = id;
+}
 
 bool BoolConst::isAnd() const {
     return false;
@@ -55,17 +298,14 @@ const BoolExpr BoolConst::negation() const {
     return buildConst(-id);
 }
 
-bool BoolConst::isLinear() const {
-    return false;
-}
+BoolConst::~BoolConst() {}
 
-bool BoolConst::isPolynomial() const {
-    return false;
+void BoolConst::initAttributes() {
+    varSet = noVars();
+    litSet = noLits();
 }
 
-BoolConst::~BoolConst() {}
-
-BoolExpr BoolConst::subs(const Subs &subs) const {
+BoolExpr BoolConst::_subs(const Subs &subs) const {
     return shared_from_this();
 }
 
@@ -81,14 +321,6 @@ BoolExpr BoolConst::toLeq() const {
     return shared_from_this();
 }
 
-void BoolConst::collectLits(RelSet &res) const {}
-
-void BoolConst::collectVars(VarSet &res) const {}
-
-size_t BoolConst::size() const {
-    return 1;
-}
-
 BoolExpr BoolConst::replaceRels(const RelMap<BoolExpr> map) const {
     return shared_from_this();
 }
@@ -97,12 +329,15 @@ void BoolConst::dnf(std::vector<Guard> &res) const {
     assert(false && "not supported");
 }
 
-unsigned BoolConst::hash() const {
-    return id;
+bool BoolConst::shallowEquals(const BoolExpression &that) const {
+    const option<int> &thatId = that.getConst();
+    return thatId && thatId.get() == id;
 }
 
 
-BoolLit::BoolLit(const Rel &lit): lit(lit.makeRhsZero()) { }
+BoolLit::BoolLit(const Rel &lit): lit(lit.makeRhsZero()) {
+    hashValue = this->lit.hash();
+}
 
 bool BoolLit::isAnd() const {
     return false;
@@ -125,18 +360,17 @@ BoolExprSet BoolLit::getChildren() const {
 }
 
 const BoolExpr BoolLit::negation() const {
-    return BoolExpr(new BoolLit(!lit));
-}
-
-bool BoolLit::isLinear() const {
-    return lit.isLinear();
+    return buildLit(!lit);
 }
 
-bool BoolLit::isPolynomial() const {
-    return lit.isPoly();
+void BoolLit::initAttributes() {
+    linear = lit.isLinear();
+    polynomial = lit.isPoly();
+    varSet = std::make_shared<const VarSet>(lit.vars());
+    litSet = std::make_shared<const RelSet>(RelSet{lit});
 }
 
-BoolExpr BoolLit::subs(const Subs &subs) const {
+BoolExpr BoolLit::_subs(const Subs &subs) const {
     return buildLit(lit.subs(subs));
 }
 
@@ -175,19 +409,6 @@ bool BoolLit::isConjunction() const {
     return true;
 }
 
-size_t BoolLit::size() const {
-    return 1;
-}
-
-void BoolLit::collectLits(RelSet &res) const {
-    res.insert(lit);
-}
-
-void BoolLit::collectVars(VarSet &res) const {
-    const VarSet &litVars = lit.vars();
-    res.insert(litVars.begin(), litVars.end());
-}
-
 BoolExpr BoolLit::replaceRels(const RelMap<BoolExpr> map) const {
     if (map.count(lit) > 0) {
         return map.at(lit);
@@ -206,14 +427,21 @@ void BoolLit::dnf(std::vector<Guard> &res) const {
     }
 }
 
-unsigned BoolLit::hash() const {
-    return lit.hash();
+bool BoolLit::shallowEquals(const BoolExpression &that) const {
+    const option<Rel> &thatLit = that.getLit();
+    return thatLit && thatLit.get() == lit;
 }
 
 BoolLit::~BoolLit() {}
 
 
-BoolJunction::BoolJunction(const BoolExprSet &children, ConcatOperator op): children(children), op(op) { }
+BoolJunction::BoolJunction(const BoolExprSet &children, ConcatOperator op): children(children), op(op) {
+    hashValue = 7;
+    for (const BoolExpr& c: children) {
+        hashValue = 31 * hashValue + c->hash();
+    }
+    hashValue = 31 * hashValue + op;
+}
 
 bool BoolJunction::isAnd() const {
     return op == ConcatAnd;
@@ -247,25 +475,24 @@ const BoolExpr BoolJunction::negation() const {
     throw std::invalid_argument("unknown junction");
 }
 
-bool BoolJunction::isLinear() const {
-    for (const BoolExpr &e: children) {
-        if (!e->isLinear()) {
-            return false;
-        }
-    }
-    return true;
-}
-
-bool BoolJunction::isPolynomial() const {
-    for (const BoolExpr &e: children) {
-        if (!e->isPolynomial()) {
-            return false;
-        }
+void BoolJunction::initAttributes() {
+    linear = true;
+    polynomial = true;
+    nodeCount = 1;
+    std::vector<std::shared_ptr<const VarSet>> childVars;
+    std::vector<std::shared_ptr<const RelSet>> childLits;
+    for (const BoolExpr &c: children) {
+        linear &= c->linear;
+        polynomial &= c->polynomial;
+        nodeCount += c->nodeCount;
+        childVars.push_back(c->varSet);
+        childLits.push_back(c->litSet);
     }
-    return true;
+    varSet = unite(childVars, noVars());
+    litSet = unite(childLits, noLits());
 }
 
-BoolExpr BoolJunction::subs(const Subs &subs) const {
+BoolExpr BoolJunction::_subs(const Subs &subs) const {
     BoolExprSet newChildren;
     for (const BoolExpr &c: children) {
         newChildren.insert(c->subs(subs));
@@ -295,26 +522,6 @@ bool BoolJunction::isConjunction() const {
     });
 }
 
-size_t BoolJunction::size() const {
-    size_t res = 1;
-    for (const BoolExpr &c: children) {
-        res += c->size();
-    }
-    return res;
-}
-
-void BoolJunction::collectLits(RelSet &res) const {
-    for (const BoolExpr &c: children) {
-        c->collectLits(res);
-    }
-}
-
-void BoolJunction::collectVars(VarSet &res) const {
-    for (const BoolExpr &c: children) {
-        c->collectVars(res);
-    }
-}
-
 BoolExpr BoolJunction::replaceRels(const RelMap<BoolExpr> map) const {
     BoolExprSet newChildren;
     for (const BoolExpr &c: children) {
@@ -342,13 +549,15 @@ void BoolJunction::dnf(std::vector<Guard> &res) const {
     }
 }
 
-unsigned BoolJunction::hash() const {
-    unsigned hash = 7;
-    for (const BoolExpr& c: children) {
-        hash = 31 * hash + c->hash();
+bool BoolJunction::shallowEquals(const BoolExpression &that) const {
+    const BoolJunction *junction = dynamic_cast<const BoolJunction*>(&that);
+    if (!junction || junction->op != op || junction->children.size() != children.size()) {
+        return false;
     }
-    hash = 31 * hash + op;
-    return hash;
+    // equal children are identical, and both sets are ordered structurally
+    return std::equal(children.begin(), children.end(), junction->children.begin(), [](const BoolExpr &a, const BoolExpr &b) {
+        return a.get() == b.get();
+    });
 }
 
 BoolJunction::~BoolJunction() {}
@@ -376,7 +585,7 @@ BoolExpr build(BoolExprSet xs, ConcatOperator op) {
     if (children.size() == 1) {
         return *children.begin();
     }
-    return BoolExpr(new BoolJunction(children, op));
+    return Interning::intern(std::make_shared<BoolJunction>(children, op));
 }
 
 BoolExpr build(const RelSet &xs, ConcatOperator op) {
@@ -396,7 +605,7 @@ const BoolExpr buildAnd(const BoolExprSet &xs) {
 }
 
 const BoolExpr buildConjunctiveClause(const BoolExprSet &xs) {
-    return BoolExpr(new BoolJunction(xs, ConcatAnd));
+    return Interning::intern(std::make_shared<BoolJunction>(xs, ConcatAnd));
 }
 
 const BoolExpr buildOr(const RelSet &xs) {
@@ -424,11 +633,11 @@ const BoolExpr buildOr(const std::vector<BoolExpr> &xs) {
 }
 
 const BoolExpr buildLit(const Rel &lit) {
-    return BoolExpr(new BoolLit(lit));
+    return Interning::intern(std::make_shared<BoolLit>(lit));
 }
 
 const BoolExpr buildConst(int id) {
-    return BoolExpr(new BoolConst(id));
+    return Interning::intern(std::make_shared<BoolConst>(id));
 }
 
 const BoolExpr True = buildAnd(std::vector<BoolExpr>());
@@ -457,19 +666,8 @@ const BoolExpr operator !(const BoolExpr a) {
 }
 
 bool operator ==(const BoolExpr a, const BoolExpr b) {
-    if (a->getConst() != b->getConst()) {
-        return false;
-    }
-    if (a->getLit() != b->getLit()) {
-        return false;
-    }
-    if (a->getLit()) {
-        return true;
-    }
-    if (a->isAnd() != b->isAnd()) {
-        return false;
-    }
-    return a->getChildren() == b->getChildren();
+    // formulas are interned
+    return a.get() == b.get();
 }
 
 bool operator !=(const BoolExpr a, const BoolExpr b) {
@@ -477,6 +675,9 @@ bool operator !=(const BoolExpr a, const BoolExpr b) {
 }
 
 bool boolexpr_compare::operator() (BoolExpr a, BoolExpr b) const {
+    if (a.get() == b.get()) {
+        return false;
+    }
     if (a->getConst()) {
         if (!b->getConst()) {
             return true;
@@ -484,6 +685,9 @@ bool boolexpr_compare::operator() (BoolExpr a, BoolExpr b) const {
             return a->getConst().get() < b->getConst().get();
         }
     }
+    if (b->getConst()) {
+        return false;
+    }
     if (a->getLit()) {
         if (!b->getLit()) {
             return true;
@@ -491,6 +695,9 @@ bool boolexpr_compare::operator() (BoolExpr a, BoolExpr b) const {
             return a->getLit().get() < b->getLit().get();
         }
     }
+    if (b->getLit()) {
+        return false;
+    }
     if (a->isAnd() && !b->isAnd()) {
         return true;
     }
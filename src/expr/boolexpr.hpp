@@ -20,11 +20,17 @@ struct boolexpr_compare {
 
 typedef std::set<BoolExpr, boolexpr_compare> BoolExprSet;
 
+/**
+ * Formulas are hash-consed: All nodes are created via the build* functions below, which return
+ * the existing node if a structurally equal one is still alive. Hence, structurally equal formulas
+ * are represented by the same node and equality is pointer equality.
+ */
 class BoolExpression: public std::enable_shared_from_this<BoolExpression> {
 
     friend class BoolLit;
     friend class BoolJunction;
     friend class BoolConst;
+    friend struct Interning;
 
 public:
     virtual option<Rel> getLit() const = 0;
@@ -33,25 +39,63 @@ public:
     virtual bool isOr() const = 0;
     virtual BoolExprSet getChildren() const = 0;
     virtual const BoolExpr negation() const = 0;
-    virtual bool isLinear() const = 0;
-    virtual bool isPolynomial() const = 0;
+    bool isLinear() const;
+    bool isPolynomial() const;
     virtual ~BoolExpression();
-    virtual BoolExpr subs(const Subs &subs) const = 0;
-    RelSet lits() const;
-    VarSet vars() const;
+    BoolExpr subs(const Subs &subs) const;
+    const RelSet& lits() const;
+    const VarSet& vars() const;
     std::vector<Guard> dnf() const;
     virtual bool isConjunction() const = 0;
     Guard conjunctionToGuard() const;
     virtual BoolExpr toG() const = 0;
     virtual BoolExpr toLeq() const = 0;
-    virtual void collectLits(RelSet &res) const = 0;
-    virtual void collectVars(VarSet &res) const = 0;
-    virtual size_t size() const = 0;
+    void collectLits(RelSet &res) const;
+    void collectVars(VarSet &res) const;
+    size_t size() const;
     virtual BoolExpr replaceRels(const RelMap<BoolExpr> map) const = 0;
-    virtual unsigned hash() const = 0;
+    unsigned hash() const;
 
 protected:
     virtual void dnf(std::vector<Guard> &res) const = 0;
+
+    // applies subs, called by subs() if subs affects this node and the result is not memoized (see SubsMemo)
+    virtual BoolExpr _subs(const Subs &subs) const = 0;
+
+    // checks structural equality, where children are compared by identity (since they are interned)
+    virtual bool shallowEquals(const BoolExpression &that) const = 0;
+
+    /**
+     * Computes the attributes below. Called once for every node that is added to the intern table,
+     * so they are not computed for temporary nodes that turn out to exist already.
+     */
+    virtual void initAttributes() = 0;
+
+    // computed on construction
+    unsigned hashValue = 0;
+
+    // immutable after initAttributes(), the sets are shared with children where possible
+    bool linear = false;
+    bool polynomial = false;
+    size_t nodeCount = 1;
+    std::shared_ptr<const VarSet> varSet;
+    std::shared_ptr<const RelSet> litSet;
+};
+
+/**
+ * While an instance is alive, the results of BoolExpression::subs are memoized on the current thread.
+ * Within a chaining round, the same update is applied to many guards, which often share subformulas,
+ * so those are only substituted once. Instances may be nested, the memo is cleared when the outermost one dies.
+ */
+class SubsMemo {
+
+public:
+
+    SubsMemo();
+    ~SubsMemo();
+    SubsMemo(const SubsMemo &that) = delete;
+    SubsMemo& operator=(const SubsMemo &that) = delete;
+
 };
 
 class BoolConst: public BoolExpression {
@@ -69,21 +113,17 @@ public:
     option<int> getConst() const override;
     BoolExprSet getChildren() const override;
     const BoolExpr negation() const override;
-    bool isLinear() const override;
-    bool isPolynomial() const override;
     ~BoolConst() override;
-    BoolExpr subs(const Subs &subs) const override;
     bool isConjunction() const override;
     BoolExpr toG() const override;
     BoolExpr toLeq() const override;
-    void collectLits(RelSet &res) const override;
-    void collectVars(VarSet &res) const override;
-    size_t size() const override;
     BoolExpr replaceRels(const RelMap<BoolExpr> map) const override;
-    unsigned hash() const override;
 
 protected:
     void dnf(std::vector<Guard> &res) const override;
+    BoolExpr _subs(const Subs &subs) const override;
+    bool shallowEquals(const BoolExpression &that) const override;
+    void initAttributes() override;
 
 };
 
@@ -102,21 +142,17 @@ public:
     option<int> getConst() const override;
     BoolExprSet getChildren() const override;
     const BoolExpr negation() const override;
-    bool isLinear() const override;
-    bool isPolynomial() const override;
     ~BoolLit() override;
-    BoolExpr subs(const Subs &subs) const override;
     bool isConjunction() const override;
     BoolExpr toG() const override;
     BoolExpr toLeq() const override;
-    void collectLits(RelSet &res) const override;
-    void collectVars(VarSet &res) const override;
-    size_t size() const override;
     BoolExpr replaceRels(const RelMap<BoolExpr> map) const override;
-    unsigned hash() const override;
 
 protected:
     void dnf(std::vector<Guard> &res) const override;
+    BoolExpr _subs(const Subs &subs) const override;
+    bool shallowEquals(const BoolExpression &that) const override;
+    void initAttributes() override;
 
 };
 
@@ -138,21 +174,17 @@ public:
     option<int> getConst() const override;
     BoolExprSet getChildren() const override;
     const BoolExpr negation() const override;
-    bool isLinear() const override;
-    bool isPolynomial() const override;
     ~BoolJunction() override;
-    BoolExpr subs(const Subs &subs) const override;
     bool isConjunction() const override;
     BoolExpr toG() const override;
     BoolExpr toLeq() const override;
-    void collectLits(RelSet &res) const override;
-    void collectVars(VarSet &res) const override;
-    size_t size() const override;
     BoolExpr replaceRels(const RelMap<BoolExpr> map) const override;
-    unsigned hash() const override;
 
 protected:
     void dnf(std::vector<Guard> &res) const override;
+    BoolExpr _subs(const Subs &subs) const override;
+    bool shallowEquals(const BoolExpression &that) const override;
+    void initAttributes() override;
 
 };
 
@@ -0,0 +1,75 @@
+#include "dnfcursor.hpp"
+#include "../smt/smt.hpp"
+
+DnfCursor::DnfCursor(const BoolExpr e, const VariableManager &varMan, unsigned int budget): varMan(varMan), budget(budget) {
+    Frame init;
+    init.pending.push_back(e);
+    todo.push(init);
+}
+
+option<Guard> DnfCursor::next() {
+    while (!todo.empty() && !exhausted) {
+        Frame current = std::move(todo.top());
+        todo.pop();
+        if (expand(current) && isSat(current) && spend()) {
+            return {current.lits};
+        }
+    }
+    return {};
+}
+
+bool DnfCursor::expand(Frame &current) {
+    while (!current.pending.empty()) {
+        BoolExpr e = current.pending.back();
+        current.pending.pop_back();
+        const option<Rel> &lit = e->getLit();
+        if (lit) {
+            current.lits.push_back(lit.get());
+        } else if (e->isAnd()) {
+            const BoolExprSet &children = e->getChildren();
+            current.pending.insert(current.pending.end(), children.rbegin(), children.rend());
+        } else if (e->isOr()) {
+            // there is no need to branch if the conjunction built so far is already unsatisfiable
+            if (isSat(current)) {
+                // push the children in reverse order, so that they are enumerated in order
+                const BoolExprSet &children = e->getChildren();
+                for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                    Frame child = current;
+                    child.pending.push_back(*it);
+                    todo.push(std::move(child));
+                }
+            }
+            return false;
+        } else {
+            throw std::invalid_argument("boolean constants are not supported");
+        }
+    }
+    return true;
+}
+
+bool DnfCursor::isSat(Frame &frame) {
+    if (frame.lits.size() <= frame.checked) {
+        return true;
+    }
+    if (!spend()) {
+        return false;
+    }
+    if (Smt::check(buildAnd(frame.lits), varMan) == Smt::Unsat) {
+        return false;
+    }
+    frame.checked = frame.lits.size();
+    return true;
+}
+
+bool DnfCursor::spend() {
+    if (budget == 0) {
+        exhausted = true;
+        return false;
+    }
+    --budget;
+    return true;
+}
+
+bool DnfCursor::budgetExhausted() const {
+    return exhausted;
+}
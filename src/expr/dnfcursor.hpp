@@ -0,0 +1,66 @@
+#ifndef DNFCURSOR_HPP
+#define DNFCURSOR_HPP
+
+#include "boolexpr.hpp"
+#include "../its/variablemanager.hpp"
+#include "../config.hpp"
+
+#include <stack>
+
+/**
+ * Enumerates the conjunctions of the DNF of a formula one by one, without materializing the whole DNF.
+ *
+ * Whenever the enumeration branches on a disjunction, the conjunction that has been built so far
+ * is checked for satisfiability, so that all of its extensions are skipped if it is unsatisfiable.
+ * Likewise, conjunctions are only returned if they are not known to be unsatisfiable.
+ *
+ * Every SMT check and every returned conjunction counts against the given budget.
+ * Once it is exhausted, the enumeration stops, even if there are conjunctions left.
+ */
+class DnfCursor {
+
+public:
+
+    DnfCursor(const BoolExpr e, const VariableManager &varMan, unsigned int budget = Config::Limit::DnfBudget);
+
+    /**
+     * @return The next conjunction that is not known to be unsatisfiable,
+     * or none if there are no more conjunctions or the budget is exhausted.
+     */
+    option<Guard> next();
+
+    /**
+     * @return true iff the enumeration was stopped early, since the budget was exhausted.
+     */
+    bool budgetExhausted() const;
+
+private:
+
+    struct Frame {
+        Guard lits;
+        // formulas that still have to be added to lits
+        std::vector<BoolExpr> pending;
+        // the number of lits that are known to be satisfiable
+        size_t checked = 0;
+    };
+
+    /**
+     * Adds the pending formulas to the lits of the given frame until there are none left (then true is returned)
+     * or a disjunction is reached. In the latter case, a frame for each disjunct is pushed, unless
+     * the lits are unsatisfiable, and false is returned.
+     */
+    bool expand(Frame &current);
+
+    // returns false iff the lits of the given frame are unsatisfiable (or the budget is exhausted)
+    bool isSat(Frame &frame);
+
+    bool spend();
+
+    std::stack<Frame> todo;
+    const VariableManager &varMan;
+    unsigned int budget;
+    bool exhausted = false;
+
+};
+
+#endif // DNFCURSOR_HPP
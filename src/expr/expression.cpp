@@ -17,6 +17,9 @@
 
 #include "expression.hpp"
 #include "complexity.hpp"
+#include "linearform.hpp"
+#include "../config.hpp"
+#include "../util/lrucache.hpp"
 #include <sstream>
 
 using namespace std;
@@ -28,7 +31,7 @@ bool Expr_is_less::operator()(const Expr &lh, const Expr &rh) const {
 const Var Expr::NontermSymbol = GiNaC::symbol("NONTERM");
 
 void Expr::applySubs(const Subs &subs) {
-    this->ex = this->ex.subs(subs.ginacMap);
+    this->ex = this->ex.subs(subs.ginacMap());
 }
 
 bool Expr::findAll(const Expr &pattern, ExprSet &found) const {
@@ -60,6 +63,8 @@ bool Expr::isNontermSymbol() const {
 
 
 bool Expr::isLinear(const option<VarSet> &vars) const {
+    // cheap syntactic check, which suffices for most linear expressions
+    if (LinearForm::of(*this)) return true;
     VarSet theVars = vars ? vars.get() : this->vars();
     // linear expressions are always polynomials
     if (!isPoly()) return false;
@@ -359,8 +364,41 @@ Expr Expr::lcoeff(const Var &var) const {
     return ex.lcoeff(var);
 }
 
+namespace {
+
+    struct ExpandKey {
+        GiNaC::ex ex;
+
+        bool operator==(const ExpandKey &that) const {
+            return ex.is_equal(that.ex);
+        }
+    };
+
+    // GiNaC caches hashes, so this is constant-time for terms that have been hashed before
+    struct ExpandKeyHash {
+        size_t operator()(const ExpandKey &key) const {
+            return key.ex.gethash();
+        }
+    };
+
+}
+
 Expr Expr::expand() const {
-    return ex.expand();
+    // symbols and numbers are always expanded
+    if (GiNaC::is_a<GiNaC::symbol>(ex) || GiNaC::is_a<GiNaC::numeric>(ex)) {
+        return *this;
+    }
+    // the same terms (e.g., costs and updates of rules) are expanded over and over again
+    thread_local LruCache<ExpandKey, GiNaC::ex, ExpandKeyHash> cache(Config::Expand::CacheSize);
+    const GiNaC::ex *cached = cache.get({ex});
+    if (cached) {
+        return *cached;
+    }
+    GiNaC::ex res = ex.expand();
+    cache.put({ex}, res);
+    // expanding an expanded term yields the term itself
+    cache.put({res}, res);
+    return res;
 }
 
 bool Expr::has(const Expr &pattern) const {
@@ -404,11 +442,14 @@ size_t Expr::arity() const {
 }
 
 Expr Expr::subs(const Subs &map) const {
-    return ex.subs(map.ginacMap);
+    if (map.empty()) {
+        return *this;
+    }
+    return ex.subs(map.ginacMap());
 }
 
 Expr Expr::replace(const ExprMap &map) const {
-    return ex.subs(map.ginacMap, GiNaC::subs_options::algebraic);
+    return ex.subs(map.ginacMap(), GiNaC::subs_options::algebraic);
 }
 
 void Expr::traverse(GiNaC::visitor &v) const {
@@ -541,13 +582,21 @@ Subs::Subs(const Var &key, const Expr &val) {
 }
 
 Subs Subs::compose(const Subs &that) const {
+    // merge both maps, so that the keys of res are inserted in ascending order
     Subs res;
-    for (const auto &p: *this) {
-        res.put(p.first, p.second.subs(that));
-    }
-    for (const auto &p: that) {
-        if (!res.contains(p.first)) {
-            res.put(p.first, p.second);
+    Expr_is_less less;
+    auto it1 = begin();
+    auto it2 = that.begin();
+    while (it1 != end() || it2 != that.end()) {
+        if (it2 == that.end() || (it1 != end() && !less(it2->first, it1->first))) {
+            if (it2 != that.end() && !less(it1->first, it2->first)) {
+                ++it2;
+            }
+            res.put(it1->first, it1->second.subs(that));
+            ++it1;
+        } else {
+            res.put(it2->first, it2->second);
+            ++it2;
         }
     }
     return res;
@@ -571,12 +620,8 @@ Subs Subs::project(const VarSet &vars) const {
     return res;
 }
 
-void Subs::putGinac(const Var &key, const Expr &val) {
-    ginacMap[key] = val.ex;
-}
-
-void Subs::eraseGinac(const Var &key) {
-    ginacMap.erase(key);
+GiNaC::ex Subs::toGinac(const Var &key) const {
+    return key;
 }
 
 bool Subs::changes(const Var &key) const {
@@ -631,12 +676,7 @@ VarSet Subs::allVars() const {
 }
 
 unsigned Subs::hash() const {
-    unsigned hash = 7;
-    for (const auto& p: *this) {
-        hash = hash * 31 + p.first.gethash();
-        hash = hash * 31 + p.second.hash();
-    }
-    return hash;
+    return cachedHash();
 }
 
 ExprMap::ExprMap(): KeyToExprMap<Expr>() {}
@@ -645,12 +685,8 @@ ExprMap::ExprMap(const Expr &key, const Expr &val) {
     put(key, val);
 }
 
-void ExprMap::putGinac(const Expr &key, const Expr &val) {
-    ginacMap[key.ex] = val.ex;
-}
-
-void ExprMap::eraseGinac(const Expr &key) {
-    ginacMap.erase(key.ex);
+GiNaC::ex ExprMap::toGinac(const Expr &key) const {
+    return key.ex;
 }
 
 bool operator==(const Subs &m1, const Subs &m2) {
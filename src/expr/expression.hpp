@@ -19,6 +19,11 @@
 #define EXPRESSION_H
 
 #include <ginac/ginac.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
 
 #include "complexity.hpp"
 #include "../util/option.hpp"
@@ -57,6 +62,7 @@ class Expr {
      */
     friend class Subs;
     friend class ExprMap;
+    template<class Key> friend class KeyToExprMap;
 
 public:
 
@@ -246,6 +252,7 @@ public:
     /**
      * @return A normalized version of this expression up to the order of monomials.
      * @note No guarantees for non-polynomial expressions.
+     * @note The results are cached per thread, so expanding the same term again is cheap.
      */
     Expr expand() const;
 
@@ -369,62 +376,177 @@ private:
 
 };
 
+/**
+ * A map from keys to expressions, stored as a vector that is sorted by the keys.
+ * Substitutions are mostly small and built in ascending order (e.g., by compose), so this is
+ * considerably cheaper than a std::map.
+ *
+ * The corresponding GiNaC::exmap is only built (and then cached) when the map is applied to a GiNaC term.
+ * The hash is maintained incrementally.
+ */
 template<class Key>
 class KeyToExprMap {
     friend class Expr;
-    using It = typename std::map<Key, Expr, Expr_is_less>::const_iterator;
+    using Entry = std::pair<Key, Expr>;
+    using It = typename std::vector<Entry>::const_iterator;
 
 public:
 
     KeyToExprMap() {}
 
+    KeyToExprMap(const KeyToExprMap &that): entries(that.entries), hashValue(that.hashValue), ginac(std::atomic_load(&that.ginac)) {}
+
+    KeyToExprMap(KeyToExprMap &&that): entries(std::move(that.entries)), hashValue(that.hashValue), ginac(std::atomic_exchange(&that.ginac, std::shared_ptr<const GiNaC::exmap>())) {
+        that.reset();
+    }
+
+    KeyToExprMap& operator=(const KeyToExprMap &that) {
+        entries = that.entries;
+        hashValue = that.hashValue;
+        std::atomic_store(&ginac, std::atomic_load(&that.ginac));
+        return *this;
+    }
+
+    KeyToExprMap& operator=(KeyToExprMap &&that) {
+        if (this != &that) {
+            entries = std::move(that.entries);
+            hashValue = that.hashValue;
+            std::atomic_store(&ginac, std::atomic_exchange(&that.ginac, std::shared_ptr<const GiNaC::exmap>()));
+            that.reset();
+        }
+        return *this;
+    }
+
     virtual ~KeyToExprMap() {}
 
     Expr get(const Key &key) const {
-        return map.at(key);
+        It it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("key not found");
+        }
+        return it->second;
     }
 
     void put(const Key &key, const Expr &val) {
-        map[key] = val;
-        putGinac(key, val);
+        invalidateGinac();
+        hashValue += entryHash(key, val);
+        // fast path for insertions in ascending order
+        if (entries.empty() || less(entries.back().first, key)) {
+            entries.emplace_back(key, val);
+            return;
+        }
+        auto it = lowerBound(key);
+        if (it != entries.end() && !less(key, it->first)) {
+            hashValue -= entryHash(it->first, it->second);
+            it->second = val;
+        } else {
+            entries.emplace(it, key, val);
+        }
     }
 
     It begin() const {
-        return map.begin();
+        return entries.begin();
     }
 
     It end() const {
-        return map.end();
+        return entries.end();
     }
 
     It find(const Key &e) const {
-        return map.find(e);
+        It it = std::lower_bound(entries.begin(), entries.end(), e, [](const Entry &entry, const Key &key) {
+            return less(entry.first, key);
+        });
+        if (it != entries.end() && !less(e, it->first)) {
+            return it;
+        }
+        return entries.end();
     }
 
     bool contains(const Key &e) const {
-        return map.count(e) > 0;
+        return find(e) != end();
     }
 
     bool empty() const {
-        return map.empty();
+        return entries.empty();
     }
 
     unsigned int size() const {
-        return map.size();
+        return entries.size();
     }
 
     size_t erase(const Key &key) {
-        eraseGinac(key);
-        return map.erase(key);
+        auto it = lowerBound(key);
+        if (it == entries.end() || less(key, it->first)) {
+            return 0;
+        }
+        invalidateGinac();
+        hashValue -= entryHash(it->first, it->second);
+        entries.erase(it);
+        return 1;
     }
 
 protected:
-    std::map<GiNaC::ex, GiNaC::ex, GiNaC::ex_is_less> ginacMap;
-    void virtual putGinac(const Key &key, const Expr &val) = 0;
-    void virtual eraseGinac(const Key &key) = 0;
+
+    const GiNaC::exmap& ginacMap() const {
+        std::shared_ptr<const GiNaC::exmap> res = std::atomic_load(&ginac);
+        if (!res) {
+            auto map = std::make_shared<GiNaC::exmap>();
+            for (const Entry &e: entries) {
+                map->emplace_hint(map->end(), toGinac(e.first), e.second.ex);
+            }
+            // concurrent calls may build the map twice, but only one of them is published
+            // (and returned to all callers), so that the returned reference stays valid
+            std::shared_ptr<const GiNaC::exmap> expected;
+            if (std::atomic_compare_exchange_strong(&ginac, &expected, std::shared_ptr<const GiNaC::exmap>(map))) {
+                res = map;
+            } else {
+                res = expected;
+            }
+        }
+        // the map is owned by ginac until the next modification
+        return *res;
+    }
+
+    unsigned cachedHash() const {
+        return hashValue;
+    }
+
+    virtual GiNaC::ex toGinac(const Key &key) const = 0;
 
 private:
-    std::map<Key, Expr, Expr_is_less> map;
+
+    static bool less(const Key &x, const Key &y) {
+        return Expr_is_less()(x, y);
+    }
+
+    static unsigned entryHash(const Key &key, const Expr &val) {
+        // combined by addition, so that the hash can be updated when entries are added or removed
+        return (31 * Expr(key).hash() + val.hash()) * 2654435761u;
+    }
+
+    typename std::vector<Entry>::iterator lowerBound(const Key &key) {
+        return std::lower_bound(entries.begin(), entries.end(), key, [](const Entry &entry, const Key &key) {
+            return less(entry.first, key);
+        });
+    }
+
+    // leaves the (moved-from) map empty
+    void reset() {
+        entries.clear();
+        hashValue = EmptyHash;
+    }
+
+    void invalidateGinac() {
+        if (ginac) {
+            std::atomic_store(&ginac, std::shared_ptr<const GiNaC::exmap>());
+        }
+    }
+
+    static const unsigned EmptyHash = 7;
+
+    std::vector<Entry> entries;
+    unsigned hashValue = EmptyHash;
+    mutable std::shared_ptr<const GiNaC::exmap> ginac;
 
 };
 
@@ -498,9 +620,8 @@ public:
 
     unsigned hash() const;
 
-private:
-    void putGinac(const Var &key, const Expr &val) override;
-    void eraseGinac(const Var &key) override;
+protected:
+    GiNaC::ex toGinac(const Var &key) const override;
 
 };
 
@@ -511,9 +632,8 @@ public:
 
     ExprMap(const Expr &key, const Expr &val);
 
-private:
-    void putGinac(const Expr &key, const Expr &val) override;
-    void eraseGinac(const Expr &key) override;
+protected:
+    GiNaC::ex toGinac(const Expr &key) const override;
 
 };
 
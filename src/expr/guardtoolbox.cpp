@@ -81,15 +81,23 @@ std::pair<option<Expr>, option<Expr>> GuardToolbox::getBoundFromIneq(const Rel &
 }
 
 option<Expr> GuardToolbox::solveTermFor(Expr term, const Var &var, SolvingLevel level) {
-    // expand is needed before using degree/coeff
-    term = term.expand();
+    const option<LinearForm> &form = LinearForm::of(term);
+    Expr c;
+    if (form) {
+        // linear terms can be solved without expanding
+        if (!form->has(var)) return {};
+        c = form->coeff(var);
+    } else {
+        // expand is needed before using degree/coeff
+        term = term.expand();
 
-    // we can only solve linear expressions...
-    if (term.degree(var) != 1) return {};
+        // we can only solve linear expressions...
+        if (term.degree(var) != 1) return {};
 
-    // ...with rational coefficients
-    Expr c = term.coeff(var);
-    if (!c.isRationalConstant()) return {};
+        // ...with rational coefficients
+        c = term.coeff(var);
+        if (!c.isRationalConstant()) return {};
+    }
 
     bool trivialCoeff = (c.compare(1) == 0 || c.compare(-1) == 0);
 
@@ -97,7 +105,12 @@ option<Expr> GuardToolbox::solveTermFor(Expr term, const Var &var, SolvingLevel
         return {};
     }
 
-    term = (term - c*var) / (-c);
+    if (form) {
+        GiNaC::numeric coeff = c.toNum();
+        term = (form->withoutVar(var) * (-coeff).inverse()).toExpr();
+    } else {
+        term = (term - c*var) / (-c);
+    }
 
     // If c is trivial, we don't have to check if the result maps to int,
     // since we assume that all constraints in the guard map to int.
@@ -299,12 +312,12 @@ option<Rule> GuardToolbox::propagateEqualitiesBySmt(const Rule &rule, VariableMa
     }
 
     Templates templates;
-    std::unique_ptr<Smt> solver = SmtFactory::modelBuildingSolver(Smt::QF_NA, varMan, Config::Smt::SimpTimeout);
+    std::unique_ptr<Smt> solver = SmtFactory::modelBuildingSolver(Smt::QF_NA, varMan, Budget::timeout(Budget::Simplification));
     bool changed = false;
     Rule res = rule;
     for (const Var &x: tempVars) {
         solver->resetSolver();
-        VarSet relevantVars = util::RelevantVariables::find({x}, std::vector<Subs>(), rule.getGuard());
+        VarSet relevantVars = util::RelevantVariables::find({x}, std::vector<Subs>(), rule.getGuard(), varMan);
         relevantVars.erase(x);
         Templates::Template t = templates.buildTemplate(relevantVars, varMan);
         relevantVars.insert(x);
@@ -0,0 +1,190 @@
+#include "linearform.hpp"
+
+#include <algorithm>
+
+using GiNaC::numeric;
+
+/**
+ * Adds factor * e to acc and c, returns false if e is not syntactically linear.
+ */
+static bool collect(const Expr &e, const numeric &factor, VarMap<numeric> &acc, numeric &c) {
+    if (e.isRationalConstant()) {
+        c += factor * e.toNum();
+        return true;
+    } else if (e.isVar()) {
+        auto it = acc.find(e.toVar());
+        if (it == acc.end()) {
+            acc.emplace(e.toVar(), factor);
+        } else {
+            it->second += factor;
+        }
+        return true;
+    } else if (e.isAdd()) {
+        for (size_t i = 0; i < e.arity(); ++i) {
+            if (!collect(e.op(i), factor, acc, c)) {
+                return false;
+            }
+        }
+        return true;
+    } else if (e.isMul()) {
+        // at most one factor may be non-constant
+        numeric newFactor = factor;
+        option<Expr> nonConstant;
+        for (size_t i = 0; i < e.arity(); ++i) {
+            const Expr &arg = e.op(i);
+            if (arg.isRationalConstant()) {
+                newFactor *= arg.toNum();
+            } else if (nonConstant) {
+                return false;
+            } else {
+                nonConstant = arg;
+            }
+        }
+        if (nonConstant) {
+            return collect(nonConstant.get(), newFactor, acc, c);
+        }
+        c += newFactor;
+        return true;
+    }
+    return false;
+}
+
+option<LinearForm> LinearForm::of(const Expr &e) {
+    VarMap<numeric> acc;
+    numeric c;
+    if (!collect(e, 1, acc, c)) {
+        return {};
+    }
+    LinearForm res(c);
+    res.ts.reserve(acc.size());
+    for (const auto &p: acc) {
+        if (!p.second.is_zero()) {
+            res.ts.emplace_back(p);
+        }
+    }
+    return res;
+}
+
+LinearForm::LinearForm(): c(0) {}
+
+LinearForm::LinearForm(const numeric &constant): c(constant) {}
+
+const LinearForm::Terms& LinearForm::terms() const {
+    return ts;
+}
+
+const numeric& LinearForm::constant() const {
+    return c;
+}
+
+static bool varLess(const std::pair<Var, numeric> &p, const Var &x) {
+    return GiNaC::ex_is_less()(p.first, x);
+}
+
+numeric LinearForm::coeff(const Var &x) const {
+    auto it = std::lower_bound(ts.begin(), ts.end(), x, varLess);
+    if (it != ts.end() && it->first.is_equal(x)) {
+        return it->second;
+    }
+    return 0;
+}
+
+bool LinearForm::isConstant() const {
+    return ts.empty();
+}
+
+bool LinearForm::has(const Var &x) const {
+    auto it = std::lower_bound(ts.begin(), ts.end(), x, varLess);
+    return it != ts.end() && it->first.is_equal(x);
+}
+
+void LinearForm::collectVars(VarSet &res) const {
+    for (const auto &p: ts) {
+        res.insert(res.end(), p.first);
+    }
+}
+
+LinearForm LinearForm::withoutVar(const Var &x) const {
+    LinearForm res = *this;
+    auto it = std::lower_bound(res.ts.begin(), res.ts.end(), x, varLess);
+    if (it != res.ts.end() && it->first.is_equal(x)) {
+        res.ts.erase(it);
+    }
+    return res;
+}
+
+numeric LinearForm::denomLcm() const {
+    numeric res = c.denom();
+    for (const auto &p: ts) {
+        res = GiNaC::lcm(res, p.second.denom());
+    }
+    return res;
+}
+
+Expr LinearForm::toExpr() const {
+    Expr res = c;
+    for (const auto &p: ts) {
+        res = res + Expr(p.second) * p.first;
+    }
+    return res;
+}
+
+unsigned LinearForm::hash() const {
+    unsigned hash = c.gethash();
+    for (const auto &p: ts) {
+        hash = 31 * hash + p.first.gethash();
+        hash = 31 * hash + p.second.gethash();
+    }
+    return hash;
+}
+
+LinearForm LinearForm::operator*(const numeric &factor) const {
+    if (factor.is_zero()) {
+        return LinearForm();
+    }
+    LinearForm res(c * factor);
+    res.ts.reserve(ts.size());
+    for (const auto &p: ts) {
+        res.ts.emplace_back(p.first, p.second * factor);
+    }
+    return res;
+}
+
+LinearForm operator+(const LinearForm &x, const LinearForm &y) {
+    LinearForm res(x.c + y.c);
+    res.ts.reserve(x.ts.size() + y.ts.size());
+    GiNaC::ex_is_less less;
+    auto it1 = x.ts.begin();
+    auto it2 = y.ts.begin();
+    while (it1 != x.ts.end() || it2 != y.ts.end()) {
+        if (it2 == y.ts.end() || (it1 != x.ts.end() && less(it1->first, it2->first))) {
+            res.ts.push_back(*it1++);
+        } else if (it1 == x.ts.end() || less(it2->first, it1->first)) {
+            res.ts.push_back(*it2++);
+        } else {
+            numeric sum = it1->second + it2->second;
+            if (!sum.is_zero()) {
+                res.ts.emplace_back(it1->first, sum);
+            }
+            ++it1;
+            ++it2;
+        }
+    }
+    return res;
+}
+
+LinearForm operator-(const LinearForm &x, const LinearForm &y) {
+    return x + y * -1;
+}
+
+bool operator==(const LinearForm &x, const LinearForm &y) {
+    if (x.c != y.c || x.ts.size() != y.ts.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < x.ts.size(); ++i) {
+        if (!x.ts[i].first.is_equal(y.ts[i].first) || x.ts[i].second != y.ts[i].second) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,61 @@
+#ifndef LINEARFORM_HPP
+#define LINEARFORM_HPP
+
+#include "expression.hpp"
+
+#include <vector>
+
+/**
+ * A linear term c_1*x_1 + ... + c_n*x_n + c_0 with rational coefficients,
+ * stored as a vector of (variable, coefficient)-pairs that is sorted w.r.t. GiNaC::ex_is_less.
+ * Coefficients are never zero.
+ *
+ * Rel stores this representation for linear relations, so that coefficients can be
+ * looked up without expand()ing and traversing the corresponding GiNaC expressions.
+ */
+class LinearForm {
+
+public:
+
+    typedef std::vector<std::pair<Var, GiNaC::numeric>> Terms;
+
+    /**
+     * @return The linear form of e, if e is syntactically linear (i.e., a sum of rational multiples of
+     * variables and rational constants). Note that this does not expand e, so none is returned for,
+     * e.g., (x+1)^2 - x^2. Hence, a result of none does not imply that e is not linear.
+     */
+    static option<LinearForm> of(const Expr &e);
+
+    LinearForm();
+    LinearForm(const GiNaC::numeric &constant);
+
+    const Terms& terms() const;
+    const GiNaC::numeric& constant() const;
+    GiNaC::numeric coeff(const Var &x) const;
+    bool isConstant() const;
+    bool has(const Var &x) const;
+    void collectVars(VarSet &res) const;
+    LinearForm withoutVar(const Var &x) const;
+
+    /**
+     * @return The lcm of the denominators of all coefficients and the constant.
+     */
+    GiNaC::numeric denomLcm() const;
+
+    Expr toExpr() const;
+
+    unsigned hash() const;
+
+    LinearForm operator*(const GiNaC::numeric &factor) const;
+    friend LinearForm operator+(const LinearForm &x, const LinearForm &y);
+    friend LinearForm operator-(const LinearForm &x, const LinearForm &y);
+    friend bool operator==(const LinearForm &x, const LinearForm &y);
+
+private:
+
+    Terms ts;
+    GiNaC::numeric c;
+
+};
+
+#endif // LINEARFORM_HPP
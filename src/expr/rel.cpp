@@ -1,8 +1,53 @@
 #include "rel.hpp"
 
+#include <atomic>
 #include <sstream>
 
-Rel::Rel(const Expr &lhs, RelOp op, const Expr &rhs): l(lhs), r(rhs), op(op) { }
+Rel::Rel(const Expr &lhs, RelOp op, const Expr &rhs): l(lhs), r(rhs), op(op) {}
+
+Rel::Rel(const Rel &that): l(that.l), r(that.r), op(that.op), linCache(std::atomic_load(&that.linCache)) {}
+
+Rel::Rel(Rel &&that): l(std::move(that.l)), r(std::move(that.r)), op(that.op), linCache(std::atomic_exchange(&that.linCache, std::shared_ptr<const option<LinearForm>>())) {}
+
+Rel& Rel::operator=(const Rel &that) {
+    l = that.l;
+    r = that.r;
+    op = that.op;
+    std::atomic_store(&linCache, std::atomic_load(&that.linCache));
+    return *this;
+}
+
+Rel& Rel::operator=(Rel &&that) {
+    if (this != &that) {
+        l = std::move(that.l);
+        r = std::move(that.r);
+        op = that.op;
+        std::atomic_store(&linCache, std::atomic_exchange(&that.linCache, std::shared_ptr<const option<LinearForm>>()));
+    }
+    return *this;
+}
+
+const option<LinearForm>& Rel::lin() const {
+    std::shared_ptr<const option<LinearForm>> res = std::atomic_load(&linCache);
+    if (!res) {
+        auto form = std::make_shared<option<LinearForm>>();
+        const option<LinearForm> &lhsForm = LinearForm::of(l);
+        if (lhsForm) {
+            const option<LinearForm> &rhsForm = LinearForm::of(r);
+            if (rhsForm) {
+                *form = lhsForm.get() - rhsForm.get();
+            }
+        }
+        // concurrent calls may compute the linear form twice, but only one of them is published
+        std::shared_ptr<const option<LinearForm>> expected;
+        if (std::atomic_compare_exchange_strong(&linCache, &expected, std::shared_ptr<const option<LinearForm>>(form))) {
+            res = form;
+        } else {
+            res = expected;
+        }
+    }
+    return *res;
+}
 
 Rel operator<(const Expr &x, const Expr &y) {
     return Rel(x.ex, Rel::lt, y.ex);
@@ -47,10 +92,16 @@ Rel Rel::expand() const {
 }
 
 bool Rel::isPoly() const {
+    if (lin()) {
+        return true;
+    }
     return l.isPoly() && r.isPoly();
 }
 
 bool Rel::isLinear(const option<VarSet> &vars) const {
+    if (lin()) {
+        return true;
+    }
     return l.isLinear(vars) && r.isLinear(vars);
 }
 
@@ -206,18 +257,29 @@ bool Rel::isTriviallyFalse() const {
 }
 
 option<bool> Rel::checkTrivial() const {
-    Expr diff = (l - r).expand();
-    if (diff.isRationalConstant()) {
-        switch (op) {
-        case Rel::eq: return diff.isZero();
-        case Rel::neq: return !diff.isZero();
-        case Rel::lt: return diff.toNum().is_negative();
-        case Rel::leq: return !diff.toNum().is_positive();
-        case Rel::gt: return diff.toNum().is_positive();
-        case Rel::geq: return !diff.toNum().is_negative();
+    option<GiNaC::numeric> diff;
+    const option<LinearForm> &form = lin();
+    if (form) {
+        if (!form->isConstant()) {
+            return {};
         }
-        assert(false && "unknown relation");
+        diff = form->constant();
+    } else {
+        Expr ex = (l - r).expand();
+        if (!ex.isRationalConstant()) {
+            return {};
+        }
+        diff = ex.toNum();
+    }
+    switch (op) {
+    case Rel::eq: return diff->is_zero();
+    case Rel::neq: return !diff->is_zero();
+    case Rel::lt: return diff->is_negative();
+    case Rel::leq: return !diff->is_positive();
+    case Rel::gt: return diff->is_positive();
+    case Rel::geq: return !diff->is_negative();
     }
+    assert(false && "unknown relation");
     return {};
 }
 
@@ -241,6 +303,7 @@ Rel Rel::replace(const ExprMap &map) const {
 void Rel::applySubs(const Subs &subs) {
     l.applySubs(subs);
     r.applySubs(subs);
+    std::atomic_store(&linCache, std::shared_ptr<const option<LinearForm>>());
 }
 
 std::string Rel::toString() const {
@@ -263,6 +326,10 @@ Rel Rel::makeRhsZero() const {
     return Rel(l - r, op, 0);
 }
 
+const LinearForm* Rel::linearForm() const {
+    return lin().get_ptr();
+}
+
 unsigned Rel::hash() const {
     unsigned hash = 7;
     hash = 31 * hash + l.hash();
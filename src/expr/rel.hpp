@@ -2,6 +2,9 @@
 #define REL_HPP
 
 #include "expression.hpp"
+#include "linearform.hpp"
+
+#include <memory>
 
 using RelSet = std::set<Rel>;
 template <class T> using RelMap = std::map<Rel, T>;
@@ -14,6 +17,10 @@ public:
     enum RelOp {lt, leq, gt, geq, eq, neq};
 
     Rel(const Expr &lhs, RelOp op, const Expr &rhs);
+    Rel(const Rel &that);
+    Rel(Rel &&that);
+    Rel& operator=(const Rel &that);
+    Rel& operator=(Rel &&that);
 
     Expr lhs() const;
     Expr rhs() const;
@@ -28,6 +35,13 @@ public:
 
     unsigned hash() const;
 
+    /**
+     * @return The linear form of lhs - rhs, or nullptr if it is not (syntactically) linear.
+     * @note If this returns nullptr, the relation may still be linear (see LinearForm::of).
+     * @note Computed on first use, the result stays valid until this relation is modified.
+     */
+    const LinearForm* linearForm() const;
+
     /**
      * @return Moves all addends containing variables to the lhs and all other addends to the rhs, where the given parameters are consiedered to be constants.
      */
@@ -78,9 +92,17 @@ private:
     option<bool> checkTrivial() const;
     Rel toIntPoly() const;
 
+    /**
+     * @return The linear form of lhs - rhs (none if it is not syntactically linear).
+     * Computed on first use and owned by linCache until this relation is modified.
+     */
+    const option<LinearForm>& lin() const;
+
     Expr l;
     Expr r;
     RelOp op;
+    // shared by all copies, published atomically as relations are shared between threads
+    mutable std::shared_ptr<const option<LinearForm>> linCache;
 
 };
 
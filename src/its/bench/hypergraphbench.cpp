@@ -0,0 +1,158 @@
+/**
+ * Measures the graph operations of HyperGraph that are used by ITSProblem on large, randomly generated graphs,
+ * mimicking the workload of the analysis: queries during DFS traversals, chaining (which eliminates
+ * locations and connects their predecessors with their successors) and pruning (which removes transitions).
+ *
+ * Usage: loat-hypergraph-bench [<number of locations>...]
+ * By default, graphs with 10000, 20000 and 40000 locations are used. If the operations take constant
+ * (amortized) time, the reported time per operation should not grow with the size of the graph.
+ */
+
+#include "../hypergraph.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace std;
+
+// the average number of outgoing transitions per location
+static const unsigned TransPerLocation = 4;
+// every hyperedge has up to this many targets
+static const unsigned MaxTargets = 3;
+
+// prevents the compiler from optimizing the queries away
+static size_t sink = 0;
+
+template <typename F>
+static void measure(const string &name, size_t ops, F f) {
+    auto start = chrono::steady_clock::now();
+    f();
+    double nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    cout << "  " << left << setw(26) << name << right << setw(10) << ops << " ops"
+         << setw(12) << fixed << setprecision(1) << nanos / max<size_t>(ops, 1) << " ns/op" << endl;
+}
+
+static void run(unsigned locs) {
+    cout << "HyperGraph with " << locs << " locations:" << endl;
+    mt19937 rng(42);
+    uniform_int_distribution<unsigned> randomLoc(0, locs - 1);
+    uniform_int_distribution<unsigned> randomTargetCount(1, MaxTargets);
+
+    HyperGraph<LocationIdx> graph;
+    const size_t transCount = static_cast<size_t>(locs) * TransPerLocation;
+
+    measure("addTrans", transCount, [&]() {
+        // a path through all locations (so that everything is reachable), plus random hyperedges
+        for (LocationIdx l = 0; l + 1 < locs; ++l) {
+            graph.addTrans(l, l + 1);
+        }
+        for (size_t i = locs; i < transCount + 1; ++i) {
+            set<LocationIdx> targets;
+            for (unsigned j = randomTargetCount(rng); j > 0; --j) {
+                targets.insert(randomLoc(rng));
+            }
+            graph.addTrans(randomLoc(rng), targets);
+        }
+    });
+
+    measure("hasTransFrom/hasTransTo", 2 * locs, [&]() {
+        for (LocationIdx l = 0; l < locs; ++l) {
+            sink += graph.hasTransFrom(l) + graph.hasTransTo(l);
+        }
+    });
+
+    measure("hasTransFromTo", transCount, [&]() {
+        for (size_t i = 0; i < transCount; ++i) {
+            sink += graph.hasTransFromTo(randomLoc(rng), randomLoc(rng));
+        }
+    });
+
+    measure("getTransFrom/getTransTo", 2 * locs, [&]() {
+        for (LocationIdx l = 0; l < locs; ++l) {
+            sink += graph.getTransFrom(l).size() + graph.getTransTo(l).size();
+        }
+    });
+
+    measure("getTransFromTo", locs, [&]() {
+        for (LocationIdx l = 0; l + 1 < locs; ++l) {
+            sink += graph.getTransFromTo(l, l + 1).size();
+        }
+    });
+
+    measure("getSuccessors (DFS)", locs, [&]() {
+        vector<bool> visited(locs, false);
+        vector<LocationIdx> todo = {0};
+        while (!todo.empty()) {
+            LocationIdx l = todo.back();
+            todo.pop_back();
+            if (visited[l]) continue;
+            visited[l] = true;
+            for (LocationIdx succ : graph.getSuccessors(l)) {
+                todo.push_back(succ);
+            }
+        }
+        sink += visited.size();
+    });
+
+    measure("getPredecessors", locs, [&]() {
+        for (LocationIdx l = 0; l < locs; ++l) {
+            sink += graph.getPredecessors(l).size();
+        }
+    });
+
+    // prune: remove every other transition
+    const vector<TransIdx> all = graph.getAllTrans();
+    measure("removeTrans", all.size() / 2, [&]() {
+        for (size_t i = 0; i < all.size(); i += 2) {
+            graph.removeTrans(all[i]);
+        }
+    });
+
+    // chain: eliminate a quarter of the locations, connecting their predecessors with their successors
+    size_t eliminated = 0;
+    measure("chain (remove/add)", locs / 4, [&]() {
+        for (LocationIdx l = 1; l < locs; l += 4) {
+            const set<LocationIdx> preds = graph.getPredecessors(l);
+            set<LocationIdx> succs = graph.getSuccessors(l);
+            succs.erase(l);
+            graph.removeNode(l);
+            if (!succs.empty()) {
+                for (LocationIdx pred : preds) {
+                    if (pred != l) {
+                        graph.addTrans(pred, succs);
+                    }
+                }
+            }
+            ++eliminated;
+        }
+    });
+
+    measure("getAllTrans", graph.getTransCount(), [&]() {
+        sink += graph.getAllTrans().size();
+    });
+
+    cout << "  (" << graph.getTransCount() << " transitions left after eliminating " << eliminated << " locations)" << endl;
+}
+
+int main(int argc, char *argv[]) {
+    vector<unsigned> sizes;
+    for (int i = 1; i < argc; ++i) {
+        int size = atoi(argv[i]);
+        if (size <= 1) {
+            cerr << "Error: invalid number of locations " << argv[i] << endl;
+            return 1;
+        }
+        sizes.push_back(size);
+    }
+    if (sizes.empty()) {
+        sizes = {10000, 20000, 40000};
+    }
+    for (unsigned locs : sizes) {
+        run(locs);
+    }
+    return sink == 0;
+}
@@ -27,28 +27,28 @@ void doExport(ITSProblem its) {
     bool found_loop = false;
     bool found_init = false;
     for (auto idx: its.getAllTransitions()) {
-        const auto& rule = its.getRule(idx);
-        if (rule.getLhsLoc() == its.getInitialLocation()) {
-            if (rule.getGuard() != True) throw std::invalid_argument("guard != True");
-            for (const auto& p: rule.getUpdate(0)) {
+        const auto rule = its.getRule(idx);
+        if (rule->getLhsLoc() == its.getInitialLocation()) {
+            if (rule->getGuard() != True) throw std::invalid_argument("guard != True");
+            for (const auto& p: rule->getUpdate(0)) {
                 if (!p.second.equals(p.first)) throw std::invalid_argument("non-trivial update");
             }
             if (found_init) throw std::invalid_argument("found_init");
             found_init = true;
         } else {
-            if (!rule.isSimpleLoop()) throw std::invalid_argument("not a simple loop");
+            if (!rule->isSimpleLoop()) throw std::invalid_argument("not a simple loop");
             if (found_loop) throw std::invalid_argument("found_loop");
             found_loop = true;
             std::stringstream cond;
-            cond << rule.getGuard()->subs(pre_vars);
+            cond << rule->getGuard()->subs(pre_vars);
             std::string cond_str = cond.str();
             boost::replace_all(cond_str, "/\\", "&&");
             boost::replace_all(cond_str, "\\/", "||");
             res << "    while (" << cond_str << ") {\n";
-            for (const auto& p: rule.getUpdate(0)) {
+            for (const auto& p: rule->getUpdate(0)) {
                 res << "        " << post_vars[p.first] << " = " << p.second.subs(pre_vars) << ";\n";
             }
-            for (const auto& p: rule.getUpdate(0)) {
+            for (const auto& p: rule->getUpdate(0)) {
                 res << "        " << pre_vars.get(p.first) << " = " << post_vars[p.first] << ";\n";
             }
             res << "    }\n";
@@ -65,7 +65,7 @@ void ITSExport::printRule(const Rule &rule, const ITSProblem &its, std::ostream
 
 void ITSExport::printLabeledRule(TransIdx rule, const ITSProblem &its, std::ostream &s) {
     s << setw(4) << rule << ": ";
-    printRule(its.getRule(rule), its, s, true);
+    printRule(*its.getRule(rule), its, s, true);
 }
 
 
@@ -144,7 +144,7 @@ void ITSExport::printKoAT(const ITSProblem &its, std::ostream &s) {
     // collect variables that actually appear in the rules
     VarSet vars;
     for (TransIdx rule : its.getAllTransitions()) {
-        VarSet rVars = its.getRule(rule).vars();
+        VarSet rVars = its.getRule(rule)->vars();
         vars.insert(rVars.begin(), rVars.end());
     }
     for (const Var &var : vars) {
@@ -164,7 +164,8 @@ void ITSExport::printKoAT(const ITSProblem &its, std::ostream &s) {
 
         //write transition in KoAT format (note that relevantVars is an ordered set)
         for (TransIdx trans : its.getTransitionsFrom(n)) {
-            const Rule &rule = its.getRule(trans);
+            const auto ruleSnapshot = its.getRule(trans);
+            const Rule &rule = ruleSnapshot.get();
             if (!rule.isSimpleLoop() || rule.getGuard()->size() < 30) continue;
             //lhs
             printNode(n);
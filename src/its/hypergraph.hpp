@@ -19,35 +19,38 @@
 #define HYPERGRAPH_H
 
 
+#include <cassert>
 #include <vector>
-#include <map>
 #include <set>
 #include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 #include "../its/types.hpp" // for TransIdx
 
 
 /**
  * A simple directed hypergraph, where each transition has a single source,
- * but (possibly) several targets. Templated over the type of Nodes.
+ * but (possibly) several targets. Templated over the type of Nodes, which have to be (small) indices.
+ *
+ * All data is stored in vectors that are indexed by nodes and transitions, respectively.
+ * Each node has a list of its outgoing and incoming transitions, where every transition occurs once
+ * (also if it has several targets). Removed transitions are not erased from these lists immediately,
+ * but marked as dead and skipped. A list is compacted once it contains more dead than live entries.
  */
 template <typename Node>
 class HyperGraph {
+    static_assert(std::is_integral<Node>::value, "nodes must be indices");
+
 public:
-    HyperGraph() : nextIdx(0) {}
+    HyperGraph() {}
 
     /**
      * Add a new transition with a single target
      * @return the index of the added transition
      */
     TransIdx addTrans(Node from, Node to) {
-        TransIdx currIdx = nextIdx++;
-        InternalTransition trans = {from, {to}};
-
-        transitions[currIdx] = std::move(trans);
-        predecessor[to].insert(from);
-        outgoing[from][to].push_back(currIdx);
-        return currIdx;
+        return addTrans(from, std::set<Node>{to});
     }
 
     /**
@@ -56,52 +59,58 @@ public:
      */
     TransIdx addTrans(Node from, std::set<Node> to) {
         assert(!to.empty());
-        TransIdx currIdx = nextIdx++;
-        InternalTransition trans = {from, to};
-        transitions[currIdx] = {from, to};
+        TransIdx currIdx = transitions.size();
 
         // An edge "f -> g,h" (from f to g and h) means that f is a predecessor of both g and h.
         // Moreover, when we query edges from f to g (or h), we want to include this edge
         // (this makes sense, since we can always simplify "f -> g,h" to just "f -> g").
         // (note that we only add one edge "f -> g" for the rule "f -> g,g" since we use sets).
-
+        addOutgoing(from, currIdx);
         for (Node t : to) {
-            predecessor[t].insert(from);
-            outgoing[from][t].push_back(currIdx);
+            addIncoming(t, currIdx);
         }
+        transitions.push_back({from, std::move(to), true});
+        ++transCount;
 
         return currIdx;
     }
 
     size_t getTransCount() const {
-        return transitions.size();
+        return transCount;
     }
 
     bool hasTransTo(Node node) const {
-        return predecessor.find(node) != predecessor.end();
+        return node < nodes.size() && nodes[node].in.live > 0;
     }
 
     bool hasTransFrom(Node node) const {
-        auto it = outgoing.find(node);
-        return it != outgoing.end() && !it->second.empty();
+        return node < nodes.size() && nodes[node].out.live > 0;
     }
 
     bool hasTransFromTo(Node from, Node to) const {
-        auto it = outgoing.find(from);
-        if (it == outgoing.end()) return false;
-
-        auto targetIt = it->second.find(to);
-        if (targetIt == it->second.end()) return false;
-
-        return !targetIt->second.empty();
+        if (!hasTransFrom(from) || !hasTransTo(to)) return false;
+        // search the shorter list
+        const Adjacency &out = nodes[from].out;
+        const Adjacency &in = nodes[to].in;
+        if (out.live <= in.live) {
+            return std::any_of(out.trans.begin(), out.trans.end(), [&](TransIdx t) {
+                return isAlive(t) && transitions[t].to.count(to) > 0;
+            });
+        } else {
+            return std::any_of(in.trans.begin(), in.trans.end(), [&](TransIdx t) {
+                return isAlive(t) && transitions[t].from == from;
+            });
+        }
     }
 
     // Returns list of all transitions (without duplicates)
     std::vector<TransIdx> getAllTrans() const {
         std::vector<TransIdx> res;
-        res.reserve(transitions.size());
-        for (const auto &it : transitions) {
-            res.push_back(it.first);
+        res.reserve(transCount);
+        for (TransIdx t = 0; t < transitions.size(); ++t) {
+            if (transitions[t].alive) {
+                res.push_back(t);
+            }
         }
         return res;
     }
@@ -109,11 +118,10 @@ public:
     // To avoid duplicates (when using hyperedges), this returns a set
     std::set<TransIdx> getTransFrom(Node from) const {
         std::set<TransIdx> res;
-        auto it = outgoing.find(from);
-        if (it != outgoing.end()) {
-            for (auto targetIt : it->second) {
-                for (TransIdx trans : targetIt.second) {
-                    res.insert(trans);
+        if (from < nodes.size()) {
+            for (TransIdx t : nodes[from].out.trans) {
+                if (isAlive(t)) {
+                    res.insert(res.end(), t);
                 }
             }
         }
@@ -123,26 +131,25 @@ public:
     // The returned vector does not contain any duplicates,
     // so we prefer a vector over a set for performance
     std::vector<TransIdx> getTransFromTo(Node from, Node to) const {
-        auto it = outgoing.find(from);
-        if (it == outgoing.end()) return {};
-
-        auto targetIt = it->second.find(to);
-        if (targetIt == it->second.end()) return {};
-
-        return targetIt->second;
+        std::vector<TransIdx> res;
+        if (from < nodes.size()) {
+            for (TransIdx t : nodes[from].out.trans) {
+                if (isAlive(t) && transitions[t].to.count(to) > 0) {
+                    res.push_back(t);
+                }
+            }
+        }
+        return res;
     }
 
     // To avoid duplicates (when using hyperedges), this returns a set
     std::set<TransIdx> getTransTo(Node to) const {
-        auto pred = predecessor.find(to);
-        if (pred == predecessor.end()) {
-            return {};
-        }
-
         std::set<TransIdx> res;
-        for (Node from : pred->second) {
-            for (TransIdx trans : getTransFromTo(from, to)) {
-                res.insert(trans);
+        if (to < nodes.size()) {
+            for (TransIdx t : nodes[to].in.trans) {
+                if (isAlive(t)) {
+                    res.insert(res.end(), t);
+                }
             }
         }
         return res;
@@ -150,22 +157,30 @@ public:
 
     std::set<Node> getSuccessors(Node node) const {
         std::set<Node> res;
-        auto it = outgoing.find(node);
-        if (it != outgoing.end()) {
-            for (auto targetIt : it->second) {
-                res.insert(targetIt.first);
+        if (node < nodes.size()) {
+            for (TransIdx t : nodes[node].out.trans) {
+                if (isAlive(t)) {
+                    res.insert(transitions[t].to.begin(), transitions[t].to.end());
+                }
             }
         }
         return res;
     }
 
     std::set<Node> getPredecessors(Node node) const {
-        auto it = predecessor.find(node);
-        return (it == predecessor.end()) ? std::set<Node>() : it->second;
+        std::set<Node> res;
+        if (node < nodes.size()) {
+            for (TransIdx t : nodes[node].in.trans) {
+                if (isAlive(t)) {
+                    res.insert(transitions[t].from);
+                }
+            }
+        }
+        return res;
     }
 
-    inline Node getTransSource(TransIdx idx) const { return transitions.at(idx).from; }
-    inline const std::set<Node>& getTransTargets(TransIdx idx) const { return transitions.at(idx).to; }
+    inline Node getTransSource(TransIdx idx) const { return getTrans(idx).from; }
+    inline const std::set<Node>& getTransTargets(TransIdx idx) const { return getTrans(idx).to; }
 
 
     /**
@@ -173,15 +188,21 @@ public:
      * (no new transition is added, data is kept)
      */
     void changeTransTargets(TransIdx trans, std::set<Node> newTargets) {
-        removeTransFromGraph(trans);
-        InternalTransition &t = transitions[trans];
+        InternalTransition &t = transitions.at(trans);
+        assert(t.alive);
 
+        for (Node to : t.to) {
+            if (newTargets.count(to) == 0) {
+                removeIncoming(to, trans);
+            }
+        }
         for (Node to : newTargets) {
-            outgoing[t.from][to].push_back(trans);
-            predecessor[to].insert(t.from);
+            if (t.to.count(to) == 0) {
+                addIncoming(to, trans);
+            }
         }
 
-        t.to = newTargets;
+        t.to = std::move(newTargets);
     }
 
     /**
@@ -190,24 +211,17 @@ public:
      * @note afterwards, node has only incoming, newOutgoing only outgoing transitions
      */
     void splitNode(Node node, Node newOutgoing) {
-        assert(outgoing.count(newOutgoing) == 0 && predecessor.count(newOutgoing) == 0);
+        assert(!hasTransFrom(newOutgoing) && !hasTransTo(newOutgoing));
+        if (node >= nodes.size()) return;
+        ensureNode(newOutgoing);
 
-        //move outgoing to new node
-        auto it = outgoing.find(node);
-        if (it != outgoing.end()) {
-            outgoing[newOutgoing] = it->second;
-            outgoing.erase(it);
-        }
-
-        //adjust predecessor references for all successors
-        for (Node succ : getSuccessors(newOutgoing)) {
-            predecessor[succ].erase(node);
-            predecessor[succ].insert(newOutgoing);
-        }
+        //move outgoing to new node (incoming lists refer to transitions, so they remain valid)
+        nodes[newOutgoing].out = std::move(nodes[node].out);
+        nodes[node].out = Adjacency();
 
         //adjust transitions from new node
-        for (TransIdx idx : getTransFrom(newOutgoing)) {
-            transitions[idx].from = newOutgoing;
+        for (TransIdx t : nodes[newOutgoing].out.trans) {
+            transitions[t].from = newOutgoing;
         }
     }
 
@@ -215,12 +229,7 @@ public:
      * Removes the given node, returns set of transitions that were removed in the process.
      */
     std::set<TransIdx> removeNode(Node idx) {
-        std::set<TransIdx> toRemove;
-
-        //find outgoing transitions
-        for (TransIdx out : getTransFrom(idx)) {
-            toRemove.insert(out);
-        }
+        std::set<TransIdx> toRemove = getTransFrom(idx);
 
         //find incoming transitions
         for (TransIdx in : getTransTo(idx)) {
@@ -228,108 +237,145 @@ public:
         }
 
         //remove it all
-        for (TransIdx idx : toRemove) {
-            removeTrans(idx);
+        for (TransIdx t : toRemove) {
+            removeTrans(t);
         }
 
-        assert(outgoing.count(idx) == 0);
-        assert(predecessor.count(idx) == 0);
+        assert(!hasTransFrom(idx));
+        assert(!hasTransTo(idx));
 
         return toRemove;
     }
 
     void removeTrans(TransIdx idx) {
-        removeTransFromGraph(idx);
-        transitions.erase(idx);
+        InternalTransition &t = transitions.at(idx);
+        if (!t.alive) return;
+        t.alive = false;
+        --transCount;
+
+        markDead(nodes[t.from].out);
+        for (Node to : t.to) {
+            markDead(nodes[to].in);
+        }
+        // the targets are not needed anymore, but the source is kept for debugging
+        t.to.clear();
     }
 
     enum CheckResult { Valid=0, InvalidNode, EmptyMapEntry, UnknownTrans, InvalidTrans, UnusedTrans, DuplicateTrans, InvalidPred, InvalidPredCount };
 
 private:
-    //updates outgoing, predecessor to remove given trans from it current location
-    void removeTransFromGraph(TransIdx trans) {
-        InternalTransition &t = transitions[trans];
+    struct InternalTransition {
+        Node from;
+        std::set<Node> to;
+        bool alive;
+    };
 
-        for (Node to : t.to) {
-            std::vector<TransIdx> &vec = outgoing[t.from][to];
-            vec.erase(std::find(vec.begin(),vec.end(),trans));
-            if (vec.empty()) {
-                outgoing[t.from].erase(to);
-                if (outgoing[t.from].empty()) outgoing.erase(t.from);
-                predecessor[to].erase(t.from);
-                if (predecessor[to].empty()) predecessor.erase(to);
-            }
+    // The transitions adjacent to a node, including dead ones
+    struct Adjacency {
+        std::vector<TransIdx> trans;
+        size_t live = 0;
+    };
+
+    struct NodeData {
+        Adjacency out;
+        Adjacency in;
+    };
+
+    bool isAlive(TransIdx t) const {
+        return transitions[t].alive;
+    }
+
+    const InternalTransition& getTrans(TransIdx idx) const {
+        const InternalTransition &t = transitions.at(idx);
+        if (!t.alive) {
+            throw std::out_of_range("removed transition");
+        }
+        return t;
+    }
+
+    void ensureNode(Node node) {
+        if (node >= nodes.size()) {
+            nodes.resize(node + 1);
+        }
+    }
+
+    void addOutgoing(Node from, TransIdx t) {
+        ensureNode(from);
+        nodes[from].out.trans.push_back(t);
+        ++nodes[from].out.live;
+    }
+
+    void addIncoming(Node to, TransIdx t) {
+        ensureNode(to);
+        nodes[to].in.trans.push_back(t);
+        ++nodes[to].in.live;
+    }
+
+    // eagerly removes a live transition from the incoming transitions of the given node
+    void removeIncoming(Node to, TransIdx t) {
+        std::vector<TransIdx> &vec = nodes[to].in.trans;
+        vec.erase(std::find(vec.begin(), vec.end(), t));
+        --nodes[to].in.live;
+    }
+
+    // called after a transition in adj has been removed, compacts adj if it contains too many dead transitions
+    void markDead(Adjacency &adj) {
+        --adj.live;
+        size_t dead = adj.trans.size() - adj.live;
+        if (dead > MinCompactionSize && dead > adj.live) {
+            adj.trans.erase(std::remove_if(adj.trans.begin(), adj.trans.end(), [this](TransIdx t) {
+                return !isAlive(t);
+            }), adj.trans.end());
         }
     }
 
     /**
      * Function to check the integrity of all datastructures (used for debugging and testing only)
      */
-    int check_internal(std::set<Node> *nodes) const {
-        int edgecount = 0; //counting multi-edges once only
-        std::set<TransIdx> seen;
-        for (auto it : outgoing) {
-            if (nodes && nodes->count(it.first) == 0) return InvalidNode;
-            if (it.second.empty()) return EmptyMapEntry;
-            for (auto it2 : it.second) {
-                for (TransIdx trans : it2.second) {
-                    if (nodes && nodes->count(it2.first) == 0) return InvalidNode;
-                    if (transitions.count(trans) == 0) return UnknownTrans;
-
-                    InternalTransition t = transitions.at(trans);
-                    if (t.to.empty()) return InvalidTrans;
-                    if (t.from != it.first || std::find(t.to.begin(), t.to.end(), it2.first) == t.to.end()) {
-                        // The transition does not originate in it.first or does not (among others) lead to it2.first
-                        return InvalidTrans;
-                    }
-
-                    // Duplicate transitions may occur, since "f -> g,h" is counted as "f -> g" and "f -> h"
-                    // Hence a duplicate transition is only an error for single-target edges
-                    if (seen.count(trans) > 0 && t.to.size() == 1) {
-                        return DuplicateTrans;
-                    }
-
-                    seen.insert(trans);
-                }
-                if (!it2.second.empty()) edgecount++;
+    int check_internal(std::set<Node> *nodeSet) const {
+        std::vector<unsigned> outSeen(transitions.size(), 0);
+        std::vector<unsigned> inSeen(transitions.size(), 0);
+        for (Node node = 0; node < nodes.size(); ++node) {
+            const NodeData &data = nodes[node];
+            size_t liveOut = 0;
+            for (TransIdx t : data.out.trans) {
+                if (t >= transitions.size()) return UnknownTrans;
+                if (!isAlive(t)) continue;
+                if (nodeSet && nodeSet->count(node) == 0) return InvalidNode;
+                if (transitions[t].to.empty()) return InvalidTrans;
+                // The transition does not originate in node
+                if (transitions[t].from != node) return InvalidTrans;
+                ++outSeen[t];
+                ++liveOut;
             }
-        }
-        if (seen.size() != transitions.size()) return UnusedTrans;
-
-        int cnt = 0;
-        for (auto it : predecessor) {
-            if (nodes && nodes->count(it.first) == 0) return InvalidNode;
-            if (it.second.empty()) return EmptyMapEntry;
-            for (Node node : it.second) {
-                if (nodes && nodes->count(it.first) == 0) return InvalidNode;
-                cnt++;
-                //at() will throw an exception if outgoing trans does exist
-                auto it1 = outgoing.find(node);
-                if (it1 == outgoing.end()) {
-                    return InvalidPred;
-                }
-                auto m = it1->second;
-                auto it2 = m.find(it.first);
-                if (it2 == m.end()) {
-                    return InvalidPred;
-                }
+            size_t liveIn = 0;
+            for (TransIdx t : data.in.trans) {
+                if (t >= transitions.size()) return UnknownTrans;
+                if (!isAlive(t)) continue;
+                if (nodeSet && nodeSet->count(node) == 0) return InvalidNode;
+                if (transitions[t].to.count(node) == 0) return InvalidPred;
+                ++inSeen[t];
+                ++liveIn;
             }
+            if (liveOut != data.out.live || liveIn != data.in.live) return InvalidPredCount;
+        }
+        for (TransIdx t = 0; t < transitions.size(); ++t) {
+            if (!isAlive(t)) continue;
+            if (outSeen[t] == 0) return UnusedTrans;
+            if (outSeen[t] > 1) return DuplicateTrans;
+            if (inSeen[t] != transitions[t].to.size()) return InvalidPredCount;
         }
-        if (cnt != edgecount) return InvalidPredCount;
         return Valid;
     }
 
 private:
-    struct InternalTransition {
-        Node from;
-        std::set<Node> to;
-    };
-
-    std::map<TransIdx,InternalTransition> transitions;
-    std::map<Node,std::map<Node,std::vector<TransIdx>>> outgoing;
-    std::map<Node,std::set<Node>> predecessor;
+    static const size_t MinCompactionSize = 16;
 
-    TransIdx nextIdx;
+    // indexed by TransIdx, removed transitions are kept (but marked as dead), so that indices remain stable
+    std::vector<InternalTransition> transitions;
+    // indexed by Node
+    std::vector<NodeData> nodes;
+    size_t transCount = 0;
 };
 
 
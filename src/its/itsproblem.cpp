@@ -30,7 +30,7 @@ bool ITSProblem::isEmpty() const {
 bool ITSProblem::isLinear() const {
     std::lock_guard guard(mutex);
     for (const auto &it : rules) {
-        if (!it.second.isLinear()) {
+        if (!it.second->isLinear()) {
             return false;
         }
     }
@@ -57,10 +57,19 @@ bool ITSProblem::hasRule(TransIdx transition) const {
     return rules.find(transition) != rules.end();
 }
 
-const Rule ITSProblem::getRule(TransIdx transition) const {
+Snapshot<Rule> ITSProblem::getRule(TransIdx transition) const {
     std::lock_guard guard(mutex);
     assert(rules.count(transition) > 0);
-    return rules.at(transition);
+    return Snapshot<Rule>(rules.at(transition));
+}
+
+option<TransIdx> ITSProblem::findRule(const Rule &rule) const {
+    // the aliasing constructor yields a non-owning pointer, which suffices for the lookup
+    auto it = rulesBwd.find(std::shared_ptr<const Rule>(std::shared_ptr<const Rule>(), &rule));
+    if (it == rulesBwd.end()) {
+        return {};
+    }
+    return it->second;
 }
 
 void ITSProblem::lock() {
@@ -73,7 +82,7 @@ void ITSProblem::unlock() {
 
 LinearRule ITSProblem::getLinearRule(TransIdx transition) const {
     std::lock_guard guard(mutex);
-    return rules.at(transition).toLinear();
+    return rules.at(transition)->toLinear();
 }
 
 const std::set<LocationIdx> ITSProblem::getTransitionTargets(TransIdx idx) const {
@@ -81,9 +90,16 @@ const std::set<LocationIdx> ITSProblem::getTransitionTargets(TransIdx idx) const
     return graph.getTransTargets(idx);
 }
 
-std::set<TransIdx> ITSProblem::getTransitionsFrom(LocationIdx loc) const {
+Snapshot<std::set<TransIdx>> ITSProblem::getTransitionsFrom(LocationIdx loc) const {
     std::lock_guard guard(mutex);
-    return graph.getTransFrom(loc);
+    if (loc >= locationSnapshots.size()) {
+        locationSnapshots.resize(loc + 1);
+    }
+    auto &res = locationSnapshots[loc].from;
+    if (!res) {
+        res = std::make_shared<const std::set<TransIdx>>(graph.getTransFrom(loc));
+    }
+    return Snapshot<std::set<TransIdx>>(res);
 }
 
 std::vector<TransIdx> ITSProblem::getTransitionsFromTo(LocationIdx from, LocationIdx to) const {
@@ -91,14 +107,24 @@ std::vector<TransIdx> ITSProblem::getTransitionsFromTo(LocationIdx from, Locatio
     return graph.getTransFromTo(from, to);
 }
 
-std::set<TransIdx> ITSProblem::getTransitionsTo(LocationIdx loc) const {
+Snapshot<std::set<TransIdx>> ITSProblem::getTransitionsTo(LocationIdx loc) const {
     std::lock_guard guard(mutex);
-    return graph.getTransTo(loc);
+    if (loc >= locationSnapshots.size()) {
+        locationSnapshots.resize(loc + 1);
+    }
+    auto &res = locationSnapshots[loc].to;
+    if (!res) {
+        res = std::make_shared<const std::set<TransIdx>>(graph.getTransTo(loc));
+    }
+    return Snapshot<std::set<TransIdx>>(res);
 }
 
-std::vector<TransIdx> ITSProblem::getAllTransitions() const {
+Snapshot<std::vector<TransIdx>> ITSProblem::getAllTransitions() const {
     std::lock_guard guard(mutex);
-    return graph.getAllTrans();
+    if (!allTransitionsSnapshot) {
+        allTransitionsSnapshot = std::make_shared<const std::vector<TransIdx>>(graph.getAllTrans());
+    }
+    return Snapshot<std::vector<TransIdx>>(allTransitionsSnapshot);
 }
 
 bool ITSProblem::hasTransitionsFrom(LocationIdx loc) const {
@@ -120,16 +146,23 @@ std::vector<TransIdx> ITSProblem::getSimpleLoopsAt(LocationIdx loc) const {
     std::lock_guard guard(mutex);
     vector<TransIdx> res;
     for (TransIdx rule : getTransitionsFromTo(loc, loc)) {
-        if (getRule(rule).isSimpleLoop()) {
+        if (rules.at(rule)->isSimpleLoop()) {
             res.push_back(rule);
         }
     }
     return res;
 }
 
-std::set<LocationIdx> ITSProblem::getSuccessorLocations(LocationIdx loc) const {
+Snapshot<std::set<LocationIdx>> ITSProblem::getSuccessorLocations(LocationIdx loc) const {
     std::lock_guard guard(mutex);
-    return graph.getSuccessors(loc);
+    if (loc >= locationSnapshots.size()) {
+        locationSnapshots.resize(loc + 1);
+    }
+    auto &res = locationSnapshots[loc].successors;
+    if (!res) {
+        res = std::make_shared<const std::set<LocationIdx>>(graph.getSuccessors(loc));
+    }
+    return Snapshot<std::set<LocationIdx>>(res);
 }
 
 std::set<LocationIdx> ITSProblem::getPredecessorLocations(LocationIdx loc) const {
@@ -137,20 +170,34 @@ std::set<LocationIdx> ITSProblem::getPredecessorLocations(LocationIdx loc) const
     return graph.getPredecessors(loc);
 }
 
+void ITSProblem::invalidateSnapshots(const Rule &rule) {
+    allTransitionsSnapshot.reset();
+    LocationIdx from = rule.getLhsLoc();
+    if (from < locationSnapshots.size()) {
+        locationSnapshots[from].from.reset();
+        locationSnapshots[from].successors.reset();
+    }
+    for (auto it = rule.rhsBegin(); it != rule.rhsEnd(); ++it) {
+        if (it->getLoc() < locationSnapshots.size()) {
+            locationSnapshots[it->getLoc()].to.reset();
+        }
+    }
+}
+
 void ITSProblem::removeRule(TransIdx transition) {
     std::lock_guard guard(mutex);
     graph.removeTrans(transition);
     auto it = rules.find(transition);
     if (it != rules.end()) {
+        invalidateSnapshots(*it->second);
         rulesBwd.erase(it->second);
+        rules.erase(it);
     }
-    rules.erase(transition);
 }
 
 option<TransIdx> ITSProblem::addRule(Rule rule) {
     std::lock_guard guard(mutex);
-    auto it = rulesBwd.find(rule);
-    if (it != rulesBwd.end()) {
+    if (findRule(rule)) {
         return {};
     }
     // gather target locations
@@ -161,8 +208,10 @@ option<TransIdx> ITSProblem::addRule(Rule rule) {
 
     // add transition and store mapping to rule
     TransIdx idx = graph.addTrans(rule.getLhsLoc(), rhsLocs);
-    rules.emplace(idx, rule);
-    rulesBwd.emplace(rule, idx);
+    invalidateSnapshots(rule);
+    auto shared = std::make_shared<const Rule>(std::move(rule));
+    rules.emplace(idx, shared);
+    rulesBwd.emplace(std::move(shared), idx);
     return idx;
 }
 
@@ -175,7 +224,7 @@ std::vector<TransIdx> ITSProblem::replaceRules(const std::vector<TransIdx> &toRe
         if (added) {
             result.push_back(added.get());
         } else {
-            keep.push_back(rulesBwd.find(r)->second);
+            keep.push_back(findRule(r).get());
         }
     }
     for (TransIdx idx: toReplace) {
@@ -190,6 +239,7 @@ LocationIdx ITSProblem::addLocation() {
     std::lock_guard guard(mutex);
     LocationIdx loc = nextUnusedLocation++;
     locations.insert(loc);
+    locationsSnapshot.reset();
     return loc;
 }
 
@@ -200,9 +250,12 @@ LocationIdx ITSProblem::addNamedLocation(std::string name) {
     return loc;
 }
 
-set<LocationIdx> ITSProblem::getLocations() const {
+Snapshot<set<LocationIdx>> ITSProblem::getLocations() const {
     std::lock_guard guard(mutex);
-    return locations;
+    if (!locationsSnapshot) {
+        locationsSnapshot = std::make_shared<const set<LocationIdx>>(locations);
+    }
+    return Snapshot<set<LocationIdx>>(locationsSnapshot);
 }
 
 option<string> ITSProblem::getLocationName(LocationIdx idx) const {
@@ -230,6 +283,7 @@ void ITSProblem::removeOnlyLocation(LocationIdx loc) {
     assert(loc != initialLocation);
 
     locations.erase(loc);
+    locationsSnapshot.reset();
     locationNames.erase(loc);
     set<TransIdx> removed = graph.removeNode(loc);
 
@@ -243,6 +297,7 @@ std::set<TransIdx> ITSProblem::removeLocationAndRules(LocationIdx loc) {
     assert(loc != initialLocation);
 
     locations.erase(loc);
+    locationsSnapshot.reset();
     locationNames.erase(loc);
     set<TransIdx> removed = graph.removeNode(loc);
 
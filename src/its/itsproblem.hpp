@@ -19,6 +19,7 @@
 #define ITSPROBLEM_H
 
 #include "../util/option.hpp"
+#include "../util/snapshot.hpp"
 
 #include "rule.hpp"
 #include "variablemanager.hpp"
@@ -47,8 +48,9 @@ public:
     LocationIdx getLocationIdx(const std::string &name) const;
 
     // query the rule associated with a given transition
+    // (the snapshot remains valid even if the rule is removed in the meantime, e.g., by another thread)
     bool hasRule(TransIdx transition) const;
-    const Rule getRule(TransIdx transition) const;
+    Snapshot<Rule> getRule(TransIdx transition) const;
 
     // the rule associated with the given index must be linear!
     LinearRule getLinearRule(TransIdx transition) const;
@@ -57,11 +59,12 @@ public:
     const std::set<LocationIdx> getTransitionTargets(TransIdx idx) const;
 
     // query transitions of the graph
-    std::set<TransIdx> getTransitionsFrom(LocationIdx loc) const;
+    // (snapshots are not affected by subsequent modifications, so it is safe to modify the ITS while iterating over them)
+    Snapshot<std::set<TransIdx>> getTransitionsFrom(LocationIdx loc) const;
     std::vector<TransIdx> getTransitionsFromTo(LocationIdx from, LocationIdx to) const;
-    std::set<TransIdx> getTransitionsTo(LocationIdx loc) const;
+    Snapshot<std::set<TransIdx>> getTransitionsTo(LocationIdx loc) const;
 
-    std::vector<TransIdx> getAllTransitions() const;
+    Snapshot<std::vector<TransIdx>> getAllTransitions() const;
 
     bool hasTransitionsFrom(LocationIdx loc) const;
     bool hasTransitionsFromTo(LocationIdx from, LocationIdx to) const;
@@ -71,7 +74,7 @@ public:
     std::vector<TransIdx> getSimpleLoopsAt(LocationIdx loc) const;
 
     // query nodes of the graph
-    std::set<LocationIdx> getSuccessorLocations(LocationIdx loc) const;
+    Snapshot<std::set<LocationIdx>> getSuccessorLocations(LocationIdx loc) const;
     std::set<LocationIdx> getPredecessorLocations(LocationIdx loc) const;
 
     // Mutation of Rules
@@ -84,7 +87,7 @@ public:
     LocationIdx addNamedLocation(std::string name);
 
     // Required for printing (see ITSExport)
-    std::set<LocationIdx> getLocations() const;
+    Snapshot<std::set<LocationIdx>> getLocations() const;
     option<std::string> getLocationName(LocationIdx idx) const;
     std::string getPrintableLocationName(LocationIdx idx) const; // returns "[idx]" if there is no name
 
@@ -103,13 +106,32 @@ public:
 
 protected:
 
+    // discards the cached snapshots that are affected by adding or removing the given rule
+    void invalidateSnapshots(const Rule &rule);
+
     // Main structure is the graph, where (hyper-)transitions are annotated with a RuleIdx.
     HyperGraph<LocationIdx> graph;
 
+    struct SharedRuleHash {
+        std::size_t operator()(const std::shared_ptr<const Rule> &r) const {
+            return r->hash();
+        }
+    };
+
+    struct SharedRuleApproxEqual {
+        bool operator()(const std::shared_ptr<const Rule> &fst, const std::shared_ptr<const Rule> &snd) const {
+            return fst->approxEqual(*snd, true);
+        }
+    };
+
+    // returns the index of a rule that is approximately equal to the given one, if any
+    option<TransIdx> findRule(const Rule &rule) const;
+
     // Collection of all rules, identified by the corresponding transitions in the graph.
     // The map allows to efficiently add/delete rules.
-    std::map<TransIdx, Rule> rules;
-    Rule::ApproxMap<TransIdx> rulesBwd;
+    // Rules are never modified once they have been added, so they can be shared with the callers of getRule.
+    std::map<TransIdx, std::shared_ptr<const Rule>> rules;
+    std::unordered_map<std::shared_ptr<const Rule>, TransIdx, SharedRuleHash, SharedRuleApproxEqual> rulesBwd;
 
     // the set of all locations (locations are just arbitrary numbers to allow simple addition/deletion)
     std::set<LocationIdx> locations;
@@ -123,6 +145,17 @@ protected:
     // only for output, remembers the original location names
     std::map<LocationIdx, std::string> locationNames;
 
+    // Cached results of the queries that return snapshots, computed on demand.
+    // Snapshots are never modified, but replaced by new ones (so they can be shared with the callers).
+    struct LocationSnapshots {
+        std::shared_ptr<const std::set<TransIdx>> from;
+        std::shared_ptr<const std::set<TransIdx>> to;
+        std::shared_ptr<const std::set<LocationIdx>> successors;
+    };
+    mutable std::vector<LocationSnapshots> locationSnapshots;
+    mutable std::shared_ptr<const std::vector<TransIdx>> allTransitionsSnapshot;
+    mutable std::shared_ptr<const std::set<LocationIdx>> locationsSnapshot;
+
 };
 
 
@@ -176,7 +176,7 @@ void smt2Export::doExport(const ITSProblem& its) {
     }
     Sexp transitions("or");
     for (auto idx: its.getAllTransitions()) {
-        LinearRule rule = its.getRule(idx).toLinear();
+        LinearRule rule = its.getRule(idx)->toLinear();
         Sexp src = Sexp("l" + std::to_string(rule.getLhs().getLoc()));
         Sexp dst = Sexp("l" + std::to_string(rule.getRhsLoc()));
         Sexp trans({Sexp("cfg_trans2"), Sexp("pc^0"), src, Sexp("pc^post"), dst});
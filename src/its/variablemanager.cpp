@@ -18,6 +18,8 @@
 #include "variablemanager.hpp"
 #include "itsproblem.hpp"
 
+#include <atomic>
+
 using namespace std;
 
 
@@ -28,6 +30,11 @@ bool VariableManager::isTempVar(const Var &var) const {
     return temporaryVariables.count(var) > 0;
 }
 
+bool VariableManager::isTempVar(VarId id) const {
+    std::lock_guard guard(mutex);
+    return id < temporaryIds.size() && temporaryIds[id];
+}
+
 Var VariableManager::addFreshVariable(string basename) {
     std::lock_guard guard(mutex);
     return addVariable(getFreshName(basename));
@@ -37,6 +44,11 @@ Var VariableManager::addFreshTemporaryVariable(string basename) {
     std::lock_guard guard(mutex);
     Var x = addVariable(getFreshName(basename));
     temporaryVariables.insert(x);
+    VarId id = getId(x);
+    if (temporaryIds.size() <= id) {
+        temporaryIds.resize(id + 1, false);
+    }
+    temporaryIds[id] = true;
     return x;
 }
 
@@ -59,6 +71,7 @@ Var VariableManager::addVariable(string name) {
     }
     variables.insert(sym);
     variableNameLookup.emplace(name, sym);
+    getId(sym);
 
     return sym;
 }
@@ -114,3 +127,66 @@ BoolExpr VariableManager::freshBoolVar() {
     std::lock_guard guard(mutex);
     return buildConst(boolVarCount++);
 }
+
+VarId VariableManager::getId(const Var &x) const {
+    std::lock_guard guard(mutex);
+    auto it = varIds.find(x);
+    if (it != varIds.end()) {
+        return it->second;
+    }
+    VarId id = idToVar.size();
+    varIds.emplace(x, id);
+    idToVar.push_back(x);
+    return id;
+}
+
+Var VariableManager::getVarById(VarId id) const {
+    std::lock_guard guard(mutex);
+    return idToVar.at(id);
+}
+
+VarIdSet VariableManager::getIds(const VarSet &vars) const {
+    std::lock_guard guard(mutex);
+    VarIdSet res;
+    for (const Var &x: vars) {
+        res.insert(getId(x));
+    }
+    return res;
+}
+
+VarIdSet VariableManager::getIds(const Expr &e) const {
+    std::lock_guard guard(mutex);
+    VarIdSet res;
+    e.hasVarWith([&](const Var &x) {
+        if (x != Expr::NontermSymbol) {
+            res.insert(getId(x));
+        }
+        // continue the traversal
+        return false;
+    });
+    return res;
+}
+
+VarSet VariableManager::getVars(const VarIdSet &ids) const {
+    std::lock_guard guard(mutex);
+    VarSet res;
+    for (VarId id: ids) {
+        res.insert(idToVar[id]);
+    }
+    return res;
+}
+
+static std::atomic_ulong nextUid(1);
+
+VariableManager::Uid::Uid(): value(nextUid++) {}
+
+VariableManager::Uid::Uid(const Uid &): value(nextUid++) {}
+
+VariableManager::Uid& VariableManager::Uid::operator=(const Uid &) {
+    value = nextUid++;
+    return *this;
+}
+
+unsigned long VariableManager::getUid() const {
+    return uid.value;
+}
@@ -4,6 +4,7 @@
 #include "types.hpp"
 #include "../expr/expression.hpp"
 #include "../expr/boolexpr.hpp"
+#include "../util/varidset.hpp"
 
 #include <mutex>
 
@@ -25,6 +26,7 @@ public:
     // Handling of temporary variables
     const VarSet& getTempVars() const;
     bool isTempVar(const Var &var) const;
+    bool isTempVar(VarId id) const;
 
     // Useful to iterate over all variables (for printing/debugging)
     VarSet getVars() const;
@@ -51,8 +53,26 @@ public:
 
     Expr::Type getType(const Var &x) const;
 
+    /**
+     * Dense ids for variables, to be used with VarIdSet.
+     * Ids are assigned on first use (also for variables that are not tracked by this manager)
+     * and never change afterwards.
+     */
+    VarId getId(const Var &x) const;
+    Var getVarById(VarId id) const;
+    VarIdSet getIds(const VarSet &vars) const;
+    // the ids of the variables of e (without building a VarSet first)
+    VarIdSet getIds(const Expr &e) const;
+    VarSet getVars(const VarIdSet &ids) const;
+
     BoolExpr freshBoolVar();
 
+    /**
+     * A unique id of this object. Copies get a new id, and ids are never reused
+     * (unlike addresses), so it can be used to recognize data that belongs to this manager.
+     */
+    unsigned long getUid() const;
+
     static std::recursive_mutex mutex;
 
 private:
@@ -82,6 +102,21 @@ private:
     std::map<std::string, Var> variableNameLookup;
 
     unsigned int boolVarCount = 1;
+
+    // Dense ids, lazily extended by getId (so they are mutable)
+    mutable VarMap<VarId> varIds;
+    mutable std::vector<Var> idToVar;
+    // indexed by VarId, may be shorter than idToVar (missing entries are false)
+    std::vector<bool> temporaryIds;
+
+    // yields a fresh value whenever it is created, copied or assigned
+    struct Uid {
+        Uid();
+        Uid(const Uid &that);
+        Uid& operator=(const Uid &that);
+        unsigned long value;
+    };
+    Uid uid;
 };
 
 
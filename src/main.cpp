@@ -46,6 +46,9 @@ void printHelp(char *arg0) {
     cout << "  --timeout <sec>                                  Timeout (in seconds), minimum: 10" << endl;
     cout << "  --proof-level <n>                                Detail level for proof output (0-" << Proof::maxProofLevel << ", default " << proofLevel << ")" << endl;
     cout << "  --plain                                          Disable colored output" << endl;
+    cout << "  --stats                                          Print SMT statistics to stderr after the analysis" << endl;
+    cout << "  --smt-race                                       Run yices and z3 concurrently for non-linear SMT queries" << endl;
+    cout << "  --smt-capture <file>                             Append all SMT queries to the given file (SMT-LIB2)" << endl;
     cout << "  --limit-strategy <smt|calculus|smtAndCalculus>   Strategy for limit problems" << endl;
     cout << "  --mode <complexity|non_termination>              Analysis mode" << endl;
 }
@@ -73,6 +76,12 @@ void parseFlags(int argc, char *argv[]) {
             proofLevel = atoi(getNext());
         } else if (strcmp("--plain",argv[arg]) == 0) {
             Config::Output::Colors = false;
+        } else if (strcmp("--stats",argv[arg]) == 0) {
+            Config::Output::Statistics = true;
+        } else if (strcmp("--smt-race",argv[arg]) == 0) {
+            Config::Smt::RacePortfolio = true;
+        } else if (strcmp("--smt-capture",argv[arg]) == 0) {
+            Config::Smt::CaptureFile = getNext();
         } else if (strcmp("--limit-strategy",argv[arg]) == 0) {
             const std::string &strategy = getNext();
             bool found = false;
@@ -8,7 +8,7 @@
 Merger::Merger(ITSProblem &its): its(its) {}
 
 void Merger::merge() {
-    const std::set<LocationIdx> &locs = its.getLocations();
+    const auto locs = its.getLocations();
     for (auto it1 = locs.begin(), end = locs.end(); it1 != end; ++it1) {
         for (auto it2 = it1; it2 != end; ++it2) {
             if (it1 == it2) continue;
@@ -25,8 +25,10 @@ void Merger::merge(LocationIdx from, LocationIdx to) {
         for (auto it1 = transitions.begin(), end = transitions.end(); !changed && it1 != end; ++it1) {
             for (auto it2 = it1; !changed && it2 != end; ++it2) {
                 if (it1 == it2) continue;
-                const Rule ruleA = its.getRule(*it1);
-                const Rule ruleB = its.getRule(*it2);
+                const auto ruleASnapshot = its.getRule(*it1);
+                const Rule &ruleA = ruleASnapshot.get();
+                const auto ruleBSnapshot = its.getRule(*it2);
+                const Rule &ruleB = ruleBSnapshot.get();
                 if (ruleA.getRhss().size() != ruleB.getRhss().size()) continue;
                 bool costMatch;
                 if (Config::Analysis::nonTermination()) {
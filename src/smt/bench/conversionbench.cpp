@@ -0,0 +1,108 @@
+/**
+ * Measures the conversion of guards to yices and z3 terms (see ExprToSmt), with and without the
+ * conversion caches of SmtContext.
+ *
+ * The guards mimic chaining: the i-th guard is the conjunction of a loop's guard instantiated with the
+ * first i iterations of its update, so each guard contains all literals of the previous one. As in the
+ * analysis, every guard is converted with the same context, so literals and subterms that have been
+ * converted for an earlier guard are found in the caches.
+ *
+ * Usage: loat-conversion-bench [<number of variables> [<number of chained iterations> [<rounds>]]]
+ * By default, 8 variables, 30 iterations and 5 rounds are used.
+ */
+
+#include "../exprtosmt.hpp"
+#include "../yices/yicescontext.hpp"
+#include "../z3/z3context.hpp"
+#include "../../config.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Builds the guards of a loop that has been chained with itself 1, ..., iterations times.
+ * The loop's guard consists of linear and non-linear literals that share subterms.
+ */
+static vector<BoolExpr> buildChainedGuards(VariableManager &varMan, unsigned vars, unsigned iterations) {
+    vector<Var> xs;
+    for (unsigned i = 0; i < vars; ++i) {
+        xs.push_back(varMan.addFreshVariable("x"));
+    }
+    vector<Rel> lits;
+    Subs up;
+    for (unsigned i = 0; i < vars; ++i) {
+        const Expr x = xs[i];
+        const Expr y = xs[(i + 1) % vars];
+        lits.push_back(Rel(x + 2 * y, Rel::leq, Expr(100)));
+        lits.push_back(Rel(x * y + x, Rel::gt, y * y));
+        up.put(xs[i], x + y);
+    }
+    const BoolExpr loopGuard = buildAnd(lits);
+
+    vector<BoolExpr> res;
+    BoolExpr guard = loopGuard;
+    Subs iterated = up;
+    for (unsigned i = 0; i < iterations; ++i) {
+        guard = guard & loopGuard->subs(iterated);
+        iterated = iterated.compose(up);
+        res.push_back(guard);
+    }
+    return res;
+}
+
+template <typename EXPR, typename F>
+static void measure(const string &name, const vector<BoolExpr> &guards, const VariableManager &varMan,
+                    unsigned rounds, F makeContext) {
+    double millis = 0;
+    for (unsigned r = 0; r < rounds; ++r) {
+        auto context = makeContext();
+        auto start = chrono::steady_clock::now();
+        for (const BoolExpr &g: guards) {
+            ExprToSmt<EXPR>::convert(g, *context, varMan);
+        }
+        millis += chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    cout << "  " << left << setw(28) << name << right << setw(10) << fixed << setprecision(2)
+         << millis / rounds << " ms/round" << endl;
+}
+
+static void run(const vector<BoolExpr> &guards, const VariableManager &varMan, unsigned rounds, unsigned cacheSize) {
+    z3::context z3Ctx;
+    measure<term_t>("yices, cache size " + to_string(cacheSize), guards, varMan, rounds, [&]() {
+        return make_unique<YicesContext>(cacheSize);
+    });
+    measure<z3::expr>("z3, cache size " + to_string(cacheSize), guards, varMan, rounds, [&]() {
+        return make_unique<Z3Context>(z3Ctx, cacheSize);
+    });
+}
+
+int main(int argc, char *argv[]) {
+    unsigned vars = argc > 1 ? atoi(argv[1]) : 8;
+    unsigned iterations = argc > 2 ? atoi(argv[2]) : 30;
+    unsigned rounds = argc > 3 ? atoi(argv[3]) : 5;
+    if (vars < 2 || iterations == 0 || rounds == 0) {
+        cerr << "Usage: loat-conversion-bench [<number of variables> [<number of chained iterations> [<rounds>]]]" << endl;
+        return 1;
+    }
+
+    VariableManager varMan;
+    const vector<BoolExpr> guards = buildChainedGuards(varMan, vars, iterations);
+    size_t lits = 0;
+    for (const BoolExpr &g: guards) {
+        lits += g->lits().size();
+    }
+    cout << guards.size() << " chained guards with " << vars << " variables (" << lits << " literals in total):" << endl;
+
+    yices_init();
+    run(guards, varMan, rounds, Config::Smt::ConversionCacheSize);
+    run(guards, varMan, rounds, 0);
+    yices_exit();
+
+    return 0;
+}
@@ -17,36 +17,29 @@ private:
 
 public:
 
-    CombinedSolver(S1* s1, S2* s2): s1(std::unique_ptr<S1>(s1)), s2(std::unique_ptr<S2>(s2)) {
+    CombinedSolver(const VariableManager &varMan, Logic logic, S1* s1, S2* s2): Smt(varMan, logic), s1(std::unique_ptr<S1>(s1)), s2(std::unique_ptr<S2>(s2)) {
         static_assert(std::is_base_of<Smt, S1>::value, "Derived not derived from BaseClass");
         static_assert(std::is_base_of<Smt, S2>::value, "Derived not derived from BaseClass");
     }
 
     virtual void add(const BoolExpr e) {
+        Smt::add(e);
         s1->add(e);
         s2->add(e);
     }
 
     virtual void push() {
+        Smt::push();
         s1->push();
         s2->push();
     }
 
     virtual void pop() {
+        Smt::pop();
         s1->pop();
         s2->pop();
     }
 
-    virtual Result check() {
-        Result res = s1->check();
-        if (res != Unknown) {
-            active = Fst;
-            return res;
-        }
-        active = Snd;
-        return s2->check();
-    }
-
     virtual Model model() {
         switch (active) {
         case Fst: return s1->model();
@@ -56,6 +49,7 @@ public:
     }
 
     virtual void setTimeout(unsigned int timeout) {
+        this->timeout = timeout;
         s1->setTimeout(timeout);
         s2->setTimeout(timeout);
     }
@@ -66,15 +60,31 @@ public:
     }
 
     virtual void resetSolver() {
+        Smt::resetSolver();
         s1->resetSolver();
         s2->resetSolver();
         active = None;
     }
 
+    virtual void interrupt() {
+        s1->interrupt();
+        s2->interrupt();
+    }
+
     virtual ~CombinedSolver() {}
 
 protected:
 
+    virtual Result _check() {
+        Result res = s1->_check();
+        if (res != Unknown) {
+            active = Fst;
+            return res;
+        }
+        active = Snd;
+        return s2->_check();
+    }
+
     virtual std::pair<Result, BoolExprSet> _unsatCore(const BoolExprSet &assumptions) {
         const auto& p = s1->_unsatCore(assumptions);
         if (p.first != Unknown) {
@@ -63,14 +63,15 @@ protected:
     }
 
     EXPR convertEx(const Expr &e){
-        if (e.isAdd()) {
-            return convertAdd(e);
-
-        } else if (e.isMul()) {
-            return convertMul(e);
-
-        } else if (e.isPow()) {
-            return convertPower(e);
+        if (e.isAdd() || e.isMul() || e.isPow()) {
+            // compound terms are cached, leaves are cheap to convert anyway
+            const option<EXPR> &cached = context.getCachedTerm(e);
+            if (cached) {
+                return cached.get();
+            }
+            EXPR res = e.isAdd() ? convertAdd(e) : e.isMul() ? convertMul(e) : convertPower(e);
+            context.cacheTerm(e, res);
+            return res;
 
         } else if (e.isRationalConstant()) {
             return convertNumeric(e.toNum());
@@ -130,6 +131,19 @@ protected:
         return context.pow(convertEx(e.op(0)), convertEx(e.op(1)));
     }
 
+    EXPR convertLinear(const LinearForm::Terms &terms) {
+        assert(!terms.empty());
+
+        option<EXPR> res;
+        for (const auto &p: terms) {
+            EXPR x = convertSymbol(p.first);
+            EXPR addend = p.second.is_equal(1) ? x : context.times(convertNumeric(p.second), x);
+            res = res ? context.plus(res.get(), addend) : addend;
+        }
+
+        return res.get();
+    }
+
     EXPR convertNumeric(const GiNaC::numeric &num) {
         assert(num.is_integer() || num.is_real());
 
@@ -156,9 +170,22 @@ protected:
     }
 
     EXPR convertRelational(const Rel &rel) {
+        const option<EXPR> &cached = context.getCachedLit(rel);
+        if (cached) {
+            return cached.get();
+        }
+        EXPR res = convertUncachedRelational(rel);
+        context.cacheLit(rel, res);
+        return res;
+    }
+
+    EXPR convertUncachedRelational(const Rel &rel) {
 
-        EXPR a = convertEx(rel.lhs());
-        EXPR b = convertEx(rel.rhs());
+        // lhs ~ rhs is equivalent to c_1*x_1 + ... + c_n*x_n ~ -c_0, which can be converted without traversing GiNaC terms
+        const LinearForm *form = rel.linearForm();
+        bool linear = form && !form->isConstant();
+        EXPR a = linear ? convertLinear(form->terms()) : convertEx(rel.lhs());
+        EXPR b = linear ? convertNumeric(-form->constant()) : convertEx(rel.rhs());
 
         switch (rel.relOp()) {
         case Rel::eq: return context.eq(a, b);
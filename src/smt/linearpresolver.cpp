@@ -0,0 +1,339 @@
+#include "linearpresolver.hpp"
+#include "../config.hpp"
+
+#include <iomanip>
+
+using GiNaC::numeric;
+
+std::atomic_ulong LinearPresolver::queries(0);
+std::atomic_ulong LinearPresolver::sat(0);
+std::atomic_ulong LinearPresolver::unsat(0);
+
+namespace {
+
+    /**
+     * Represents sum_i coeffs[i] * x_i + constant > 0 (if strict) or >= 0 (otherwise).
+     * Equations (= 0) are represented in the same way, the strictness is ignored for them.
+     */
+    struct Constraint {
+        std::vector<numeric> coeffs;
+        numeric constant;
+        bool strict;
+    };
+
+    numeric floor(const numeric &q) {
+        numeric res = GiNaC::iquo(q.numer(), q.denom());
+        if (q.is_negative() && !q.is_integer()) {
+            res = res - 1;
+        }
+        return res;
+    }
+
+    numeric ceil(const numeric &q) {
+        return -floor(-q);
+    }
+
+    bool isGround(const Constraint &c) {
+        for (const numeric &a: c.coeffs) {
+            if (!a.is_zero()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool holds(const numeric &val, bool strict) {
+        return strict ? val > 0 : val >= 0;
+    }
+
+    /**
+     * Converts the given (linear) relation and adds it to ineqs or eqs.
+     * @return false if the relation cannot be handled (disequations, non-numeric coefficients)
+     */
+    bool parse(const Rel &rel, const std::vector<Var> &vars, const std::vector<bool> &isInt,
+               std::vector<Constraint> &ineqs, std::vector<Constraint> &eqs) {
+        if (rel.isNeq()) {
+            return false;
+        }
+        Expr diff = (rel.lhs() - rel.rhs()).expand();
+        if (rel.relOp() == Rel::lt || rel.relOp() == Rel::leq) {
+            diff = -diff;
+        }
+        Constraint c;
+        Subs zero;
+        bool integral = true;
+        for (unsigned int i = 0; i < vars.size(); ++i) {
+            const Expr &coeff = diff.coeff(vars[i]);
+            if (!coeff.isRationalConstant()) {
+                return false;
+            }
+            c.coeffs.push_back(coeff.toNum());
+            if (!c.coeffs.back().is_zero()) {
+                integral = integral && isInt[i] && c.coeffs.back().is_integer();
+            }
+            zero.put(vars[i], 0);
+        }
+        const Expr &constant = diff.subs(zero);
+        if (!constant.isRationalConstant()) {
+            return false;
+        }
+        c.constant = constant.toNum();
+        c.strict = rel.relOp() == Rel::lt || rel.relOp() == Rel::gt;
+        // over the integers, t > 0 is equivalent to t - 1 >= 0
+        if (c.strict && integral && c.constant.is_integer()) {
+            c.constant = c.constant - 1;
+            c.strict = false;
+        }
+        if (rel.isEq()) {
+            eqs.push_back(c);
+        } else {
+            ineqs.push_back(c);
+        }
+        return true;
+    }
+
+    // substitutes x_j in c by its definition according to eq (where eq.coeffs[j] != 0)
+    void eliminate(Constraint &c, const Constraint &eq, unsigned int j) {
+        if (c.coeffs[j].is_zero()) {
+            return;
+        }
+        numeric factor = c.coeffs[j] / eq.coeffs[j];
+        for (unsigned int i = 0; i < c.coeffs.size(); ++i) {
+            c.coeffs[i] = c.coeffs[i] - factor * eq.coeffs[i];
+        }
+        c.constant = c.constant - factor * eq.constant;
+    }
+
+    // combines two constraints with coefficients of different signs for x_k such that x_k vanishes
+    Constraint combine(const Constraint &pos, const Constraint &neg, unsigned int k) {
+        const numeric p = pos.coeffs[k];
+        const numeric n = -neg.coeffs[k];
+        Constraint res;
+        for (unsigned int i = 0; i < pos.coeffs.size(); ++i) {
+            res.coeffs.push_back(n * pos.coeffs[i] + p * neg.coeffs[i]);
+        }
+        res.constant = n * pos.constant + p * neg.constant;
+        res.strict = pos.strict || neg.strict;
+        return res;
+    }
+
+    bool satisfies(const numeric &val, const option<numeric> &lower, bool lowerStrict,
+                   const option<numeric> &upper, bool upperStrict) {
+        return (!lower || holds(val - lower.get(), lowerStrict)) && (!upper || holds(upper.get() - val, upperStrict));
+    }
+
+    // picks a value within the given bounds, preferring values that are close to 0
+    option<numeric> choose(const option<numeric> &lower, bool lowerStrict,
+                           const option<numeric> &upper, bool upperStrict, bool isInt) {
+        if (isInt) {
+            option<numeric> lo, hi;
+            if (lower) {
+                lo = lowerStrict ? floor(lower.get()) + 1 : ceil(lower.get());
+            }
+            if (upper) {
+                hi = upperStrict ? ceil(upper.get()) - 1 : floor(upper.get());
+            }
+            if (lo && hi && lo.get() > hi.get()) {
+                return {};
+            }
+            if (lo && lo.get() > 0) {
+                return lo;
+            }
+            if (hi && hi.get() < 0) {
+                return hi;
+            }
+            return numeric(0);
+        }
+        if (satisfies(0, lower, lowerStrict, upper, upperStrict)) {
+            return numeric(0);
+        }
+        if (lower && upper) {
+            if (lower.get() < upper.get()) {
+                return (lower.get() + upper.get()) / 2;
+            } else if (lower.get() == upper.get() && !lowerStrict && !upperStrict) {
+                return lower;
+            }
+            return {};
+        }
+        if (lower) {
+            return lowerStrict ? lower.get() + 1 : lower.get();
+        }
+        return upperStrict ? upper.get() - 1 : upper.get();
+    }
+
+    // lits() does not contain boolean constants / variables, so formulas with such nodes cannot be decided here
+    bool hasBoolConst(const BoolExpr &e) {
+        if (e->getConst()) {
+            return true;
+        }
+        if (e->getLit()) {
+            return false;
+        }
+        for (const BoolExpr &c: e->getChildren()) {
+            if (hasBoolConst(c)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+}
+
+option<Smt::Result> LinearPresolver::check(const BoolExpr e, const VariableManager &varMan) {
+    ++queries;
+    if (!e->isConjunction()) {
+        return {};
+    }
+    const RelSet &lits = e->lits();
+    const VarSet &varSet = e->vars();
+    if (lits.size() > Config::Smt::PresolverMaxLits || varSet.size() > Config::Smt::PresolverMaxVars) {
+        return {};
+    }
+    if (hasBoolConst(e)) {
+        return {};
+    }
+    const std::vector<Var> vars(varSet.begin(), varSet.end());
+    const unsigned int n = vars.size();
+    std::vector<bool> isInt;
+    for (const Var &x: vars) {
+        isInt.push_back(varMan.getType(x) == Expr::Int);
+    }
+    std::vector<Constraint> ineqs;
+    std::vector<Constraint> eqs;
+    for (const Rel &rel: lits) {
+        if (!parse(rel, vars, isInt, ineqs, eqs)) {
+            return {};
+        }
+    }
+
+    // eliminate equations by substitution, remember the definitions for constructing a model
+    std::vector<std::pair<unsigned int, Constraint>> definitions;
+    for (unsigned int i = 0; i < eqs.size(); ++i) {
+        const Constraint eq = eqs[i];
+        option<unsigned int> j;
+        for (unsigned int k = 0; k < n; ++k) {
+            if (!eq.coeffs[k].is_zero()) {
+                j = k;
+                break;
+            }
+        }
+        if (!j) {
+            if (!eq.constant.is_zero()) {
+                ++unsat;
+                return Smt::Unsat;
+            }
+            continue;
+        }
+        for (unsigned int k = i + 1; k < eqs.size(); ++k) {
+            eliminate(eqs[k], eq, j.get());
+        }
+        for (Constraint &c: ineqs) {
+            eliminate(c, eq, j.get());
+        }
+        definitions.emplace_back(j.get(), eq);
+    }
+
+    // Fourier-Motzkin elimination, stages[k] contains the constraints before eliminating x_k
+    std::vector<std::vector<Constraint>> stages;
+    std::vector<Constraint> current = ineqs;
+    for (unsigned int k = 0; k <= n; ++k) {
+        std::vector<Constraint> pos, neg, next;
+        for (const Constraint &c: current) {
+            if (isGround(c)) {
+                if (!holds(c.constant, c.strict)) {
+                    ++unsat;
+                    return Smt::Unsat;
+                }
+            } else if (c.coeffs[k].is_zero()) {
+                next.push_back(c);
+            } else if (c.coeffs[k] > 0) {
+                pos.push_back(c);
+            } else {
+                neg.push_back(c);
+            }
+        }
+        if (k == n) {
+            break;
+        }
+        stages.push_back(current);
+        for (const Constraint &p: pos) {
+            for (const Constraint &q: neg) {
+                next.push_back(combine(p, q, k));
+            }
+        }
+        if (next.size() > Config::Smt::PresolverMaxConstraints) {
+            return {};
+        }
+        current = next;
+    }
+
+    // satisfiable over the rationals, try to build a model by back-substitution
+    std::vector<numeric> model(n, 0);
+    for (unsigned int k = n; k-- > 0;) {
+        option<numeric> lower, upper;
+        bool lowerStrict = false;
+        bool upperStrict = false;
+        for (const Constraint &c: stages[k]) {
+            if (c.coeffs[k].is_zero()) {
+                continue;
+            }
+            // all variables but x_k that occur in c have already been assigned
+            numeric rest = c.constant;
+            for (unsigned int i = k + 1; i < n; ++i) {
+                rest = rest + c.coeffs[i] * model[i];
+            }
+            const numeric bound = -rest / c.coeffs[k];
+            if (c.coeffs[k] > 0) {
+                if (!lower || bound > lower.get() || (bound == lower.get() && c.strict)) {
+                    lower = bound;
+                    lowerStrict = c.strict;
+                }
+            } else if (!upper || bound < upper.get() || (bound == upper.get() && c.strict)) {
+                upper = bound;
+                upperStrict = c.strict;
+            }
+        }
+        const option<numeric> &val = choose(lower, lowerStrict, upper, upperStrict, isInt[k]);
+        if (!val) {
+            return {};
+        }
+        model[k] = val.get();
+    }
+    for (auto it = definitions.rbegin(); it != definitions.rend(); ++it) {
+        const unsigned int j = it->first;
+        const Constraint &eq = it->second;
+        numeric rest = eq.constant;
+        for (unsigned int i = 0; i < n; ++i) {
+            if (i != j) {
+                rest = rest + eq.coeffs[i] * model[i];
+            }
+        }
+        model[j] = -rest / eq.coeffs[j];
+    }
+
+    // the rounding for integer variables may have failed, so the model has to be checked
+    Subs subs;
+    for (unsigned int i = 0; i < n; ++i) {
+        if (isInt[i] && !model[i].is_integer()) {
+            return {};
+        }
+        subs.put(vars[i], model[i]);
+    }
+    for (const Rel &rel: lits) {
+        if (!rel.subs(subs).isTriviallyTrue()) {
+            return {};
+        }
+    }
+    ++sat;
+    return Smt::Sat;
+}
+
+void LinearPresolver::printStatistics(std::ostream &s) {
+    unsigned long q = queries;
+    unsigned long decided = sat + unsat;
+    s << "Linear presolver: " << decided << " of " << q << " QF_LA queries decided (" << sat << " sat, " << unsat << " unsat";
+    if (q > 0) {
+        s << ", " << std::fixed << std::setprecision(1) << 100.0 * decided / q << "%";
+    }
+    s << ")" << std::endl;
+}
@@ -0,0 +1,41 @@
+#ifndef LINEARPRESOLVER_HPP
+#define LINEARPRESOLVER_HPP
+
+#include "smt.hpp"
+
+#include <atomic>
+#include <ostream>
+
+/**
+ * In-process decision procedure for tiny conjunctions of linear constraints,
+ * so that such queries do not have to be sent to an external solver.
+ *
+ * Equations are eliminated by substitution, the remaining inequations via Fourier-Motzkin elimination
+ * (with exact rational arithmetic). Hence, the check is complete over the rationals. Since LoAT's
+ * variables are usually integers, "unsat" is always reliable, but "sat" is only reported if
+ * the back-substitution yields a model (with integer values for integer variables)
+ * that actually satisfies all literals. In all other cases, the query is left to the SMT solver.
+ */
+class LinearPresolver {
+
+public:
+
+    /**
+     * @return Sat or Unsat if the given formula could be decided, none otherwise
+     */
+    static option<Smt::Result> check(const BoolExpr e, const VariableManager &varMan);
+
+    /**
+     * Prints how many queries were decided by the presolver (for all threads) to the given stream.
+     */
+    static void printStatistics(std::ostream &s);
+
+private:
+
+    static std::atomic_ulong queries;
+    static std::atomic_ulong sat;
+    static std::atomic_ulong unsat;
+
+};
+
+#endif // LINEARPRESOLVER_HPP
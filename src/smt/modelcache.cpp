@@ -0,0 +1,80 @@
+#include "modelcache.hpp"
+
+#include <iomanip>
+
+std::atomic_ulong ModelCache::lookups(0);
+std::atomic_ulong ModelCache::hits(0);
+
+std::list<ModelCache::Entry>& ModelCache::models() {
+    thread_local std::list<Entry> models;
+    return models;
+}
+
+bool ModelCache::isSat(const BoolExpr e, const VariableManager &varMan) {
+    std::list<Entry> &ms = models();
+    if (ms.empty()) {
+        return false;
+    }
+    ++lookups;
+    const VarSet &vars = e->vars();
+    for (auto it = ms.begin(); it != ms.end(); ++it) {
+        if (it->varManUid != varMan.getUid()) {
+            continue;
+        }
+        Subs subs;
+        bool integral = true;
+        for (const Var &x: vars) {
+            if (it->model.contains(x)) {
+                const GiNaC::numeric &val = it->model.get(x);
+                // the model may stem from a query where x was not known to be an integer
+                if (varMan.getType(x) == Expr::Int && !val.is_integer()) {
+                    integral = false;
+                    break;
+                }
+                subs.put(x, val);
+            } else {
+                subs.put(x, 0);
+            }
+        }
+        if (integral && eval(e, it->model, subs)) {
+            ++hits;
+            ms.splice(ms.begin(), ms, it);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ModelCache::eval(const BoolExpr e, const Model &model, const Subs &subs) {
+    if (e->getLit()) {
+        return e->getLit()->subs(subs).isTriviallyTrue();
+    } else if (e->getConst()) {
+        int id = e->getConst().get();
+        bool val = model.contains(std::abs(id)) && model.get(std::abs(id));
+        return id < 0 ? !val : val;
+    }
+    for (const BoolExpr &c: e->getChildren()) {
+        if (eval(c, model, subs) != e->isAnd()) {
+            return !e->isAnd();
+        }
+    }
+    return e->isAnd();
+}
+
+void ModelCache::add(const Model &model, const VariableManager &varMan) {
+    std::list<Entry> &ms = models();
+    ms.push_front({model, varMan.getUid()});
+    if (ms.size() > Config::Smt::ModelCacheSize) {
+        ms.pop_back();
+    }
+}
+
+void ModelCache::printStatistics(std::ostream &s) {
+    unsigned long l = lookups;
+    unsigned long h = hits;
+    s << "SMT model cache: " << h << " of " << l << " queries satisfied by a cached model";
+    if (l > 0) {
+        s << " (hit rate " << std::fixed << std::setprecision(1) << 100.0 * h / l << "%)";
+    }
+    s << std::endl;
+}
@@ -0,0 +1,53 @@
+#ifndef MODELCACHE_HPP
+#define MODELCACHE_HPP
+
+#include "smt.hpp"
+#include "model.hpp"
+
+#include <atomic>
+#include <list>
+#include <ostream>
+
+/**
+ * Keeps the most recent models (at most Config::Smt::ModelCacheSize per thread) that have been
+ * found by satisfiability checks.
+ *
+ * Many queries are strengthenings of formulas that have been checked before (e.g. chained guards),
+ * so they are often satisfied by a recent model. Evaluating a formula on a concrete model is much
+ * cheaper than calling a solver. Variables that do not occur in a model are set to 0 (and boolean
+ * variables to false), which is fine since any satisfying assignment proves satisfiability.
+ */
+class ModelCache {
+
+public:
+
+    // returns true if one of the cached models (wrt. the given variable manager) satisfies e
+    static bool isSat(const BoolExpr e, const VariableManager &varMan);
+
+    static void add(const Model &model, const VariableManager &varMan);
+
+    /**
+     * Prints the number of lookups and hits (for all threads) to the given stream.
+     */
+    static void printStatistics(std::ostream &s);
+
+private:
+
+    struct Entry {
+        Model model;
+        // the VariableManager::getUid() of the variable manager the model belongs to
+        // (unlike its address, the uid is never reused by another variable manager)
+        unsigned long varManUid;
+    };
+
+    // most recently used models first
+    static std::list<Entry>& models();
+
+    static bool eval(const BoolExpr e, const Model &model, const Subs &subs);
+
+    static std::atomic_ulong lookups;
+    static std::atomic_ulong hits;
+
+};
+
+#endif // MODELCACHE_HPP
@@ -0,0 +1,153 @@
+#include "racingsolver.hpp"
+
+#include <iomanip>
+
+std::atomic_ulong RacingSolver::races(0);
+std::atomic_ulong RacingSolver::wins[2] = {{0}, {0}};
+
+RacingSolver::RacingSolver(const VariableManager &varMan, Logic logic, std::unique_ptr<Smt> fst, std::unique_ptr<Smt> snd):
+    Smt(varMan, logic),
+    solvers{std::move(fst), std::move(snd)},
+    worker(&RacingSolver::work, this) {}
+
+RacingSolver::~RacingSolver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+void RacingSolver::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this]() {return pending || stop;});
+        if (stop) {
+            return;
+        }
+        pending = false;
+        lock.unlock();
+        run(Snd);
+        lock.lock();
+    }
+}
+
+void RacingSolver::run(Active me) {
+    Active other = me == Fst ? Snd : Fst;
+    bool start;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // if the other solver has already won, there is no need to start
+        start = winner == None;
+        started[me] = start;
+    }
+    Result res = start ? delegateCheck(*solvers[me]) : Unknown;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done[me] = true;
+        results[me] = res;
+        if (res != Unknown && winner == None) {
+            winner = me;
+            // if the other solver has not started yet, it will not start at all
+            if (started[other] && !done[other]) {
+                solvers[other]->interrupt();
+            }
+        }
+    }
+    cv.notify_all();
+}
+
+void RacingSolver::add(const BoolExpr e) {
+    Smt::add(e);
+    for (auto &s: solvers) {
+        s->add(e);
+    }
+}
+
+void RacingSolver::push() {
+    Smt::push();
+    for (auto &s: solvers) {
+        s->push();
+    }
+}
+
+void RacingSolver::pop() {
+    Smt::pop();
+    for (auto &s: solvers) {
+        s->pop();
+    }
+}
+
+Smt::Result RacingSolver::_check() {
+    ++races;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (unsigned int i = 0; i < 2; ++i) {
+            started[i] = false;
+            done[i] = false;
+            results[i] = Unknown;
+        }
+        winner = None;
+        pending = true;
+    }
+    cv.notify_all();
+    run(Fst);
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() {return done[Snd];});
+    active = winner;
+    if (active == None) {
+        return Unknown;
+    }
+    ++wins[active];
+    return results[active];
+}
+
+Model RacingSolver::model() {
+    if (active == None) {
+        throw std::invalid_argument("called RacingSolver::model, but no solver is active");
+    }
+    return solvers[active]->model();
+}
+
+void RacingSolver::setTimeout(unsigned int timeout) {
+    this->timeout = timeout;
+    for (auto &s: solvers) {
+        s->setTimeout(timeout);
+    }
+}
+
+void RacingSolver::enableModels() {
+    for (auto &s: solvers) {
+        s->enableModels();
+    }
+}
+
+void RacingSolver::resetSolver() {
+    Smt::resetSolver();
+    for (auto &s: solvers) {
+        s->resetSolver();
+    }
+    active = None;
+}
+
+void RacingSolver::interrupt() {
+    for (auto &s: solvers) {
+        s->interrupt();
+    }
+}
+
+std::pair<Smt::Result, BoolExprSet> RacingSolver::_unsatCore(const BoolExprSet &assumptions) {
+    for (auto &s: solvers) {
+        const auto &p = delegateUnsatCore(*s, assumptions);
+        if (p.first != Unknown) {
+            return p;
+        }
+    }
+    return {Unknown, {}};
+}
+
+void RacingSolver::printStatistics(std::ostream &s) {
+    s << "SMT portfolio: " << races << " races, won by first solver: " << wins[Fst]
+      << ", by second solver: " << wins[Snd] << std::endl;
+}
@@ -0,0 +1,81 @@
+#ifndef RACINGSOLVER_HPP
+#define RACINGSOLVER_HPP
+
+#include "smt.hpp"
+#include "../config.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+/**
+ * Runs two solvers concurrently (one on the calling thread, one on a helper thread).
+ * The first definitive answer (Sat or Unsat) wins and the other solver is interrupted.
+ * So in contrast to CombinedSolver, a hard query costs one timeout instead of two,
+ * at the price of occupying a second core.
+ *
+ * The helper thread lives as long as this solver, so a race does not start a thread.
+ * The loser of a race is interrupted once, as soon as it has started its check (or not
+ * started at all if the race is already decided). If the interrupt arrives before the loser
+ * has actually begun its search, it may get lost, and the loser stops at its own timeout.
+ * Both solvers are kept, so pooled racing solvers stay warm (see SolverPool).
+ *
+ * Unsat cores are not computed concurrently (converting the assumptions manipulates
+ * GiNaC expressions, which must not happen on two threads at once). Instead, the
+ * solvers are asked one after the other, as in CombinedSolver.
+ */
+class RacingSolver : public Smt {
+
+public:
+    RacingSolver(const VariableManager &varMan, Logic logic, std::unique_ptr<Smt> fst, std::unique_ptr<Smt> snd);
+
+    void add(const BoolExpr e) override;
+    void push() override;
+    void pop() override;
+    Model model() override;
+    void setTimeout(unsigned int timeout) override;
+    void enableModels() override;
+    void resetSolver() override;
+    void interrupt() override;
+    ~RacingSolver() override;
+
+    /**
+     * Prints how often each solver won a race (for all threads) to the given stream.
+     */
+    static void printStatistics(std::ostream &s);
+
+protected:
+    Result _check() override;
+    std::pair<Result, BoolExprSet> _unsatCore(const BoolExprSet &assumptions) override;
+
+private:
+    enum Active {Fst, Snd, None};
+
+    std::unique_ptr<Smt> solvers[2];
+    Active active = None;
+
+    // the state of the current race, protected by mutex
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool pending = false;
+    bool stop = false;
+    bool started[2] = {false, false};
+    bool done[2] = {false, false};
+    Result results[2] = {Unknown, Unknown};
+    Active winner = None;
+
+    // runs the second solver whenever a race is pending, must be declared last
+    std::thread worker;
+
+    void work();
+    void run(Active me);
+
+    static std::atomic_ulong races;
+    static std::atomic_ulong wins[2];
+
+};
+
+#endif // RACINGSOLVER_HPP
@@ -0,0 +1,336 @@
+/**
+ * Re-runs SMT queries that have been captured with --smt-capture (see SmtCapture) with yices and z3
+ * and reports latency distributions per call site, e.g. to evaluate solver updates or settings on the
+ * queries that actually arise in practice.
+ *
+ * Usage: loat-replay [--timeout <ms>] [--solver <yices|z3>] <file>...
+ * By default, each query is run with its captured timeout by both solvers.
+ */
+
+#include "../../its/smt2Parser/sexpresso/sexpresso.hpp"
+#include "../../util/watchdog.hpp"
+
+#include <yices.h>
+#include <z3++.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace sexpresso;
+
+struct Query {
+    string site = "other";
+    string logic = "QF_LA";
+    string result = "unknown";
+    unsigned int timeout = 0;
+    double latency = 0;
+    vector<Sexp> commands;
+};
+
+struct Run {
+    string result;
+    double latency;
+};
+
+// latencies and results of one solver at one call site
+struct Stats {
+    vector<double> latencies;
+    map<string, unsigned int> results;
+    // definitive answers that contradict the captured result
+    unsigned int conflicts = 0;
+};
+
+vector<Query> load(const string &filename) {
+    ifstream in(filename);
+    if (!in) {
+        cerr << "Error: cannot open " << filename << endl;
+        exit(1);
+    }
+    vector<Query> res;
+    stringstream body;
+    string line;
+    auto finish = [&]() {
+        if (!res.empty()) {
+            string err;
+            Sexp parsed = parse(body.str(), err);
+            if (!err.empty()) {
+                cerr << "Error: cannot parse query from " << filename << ": " << err << endl;
+                exit(1);
+            }
+            res.back().commands = parsed.value.sexp;
+        }
+        body.str("");
+    };
+    while (getline(in, line)) {
+        if (line.compare(0, 8, "; query ") == 0) {
+            finish();
+            res.emplace_back();
+        } else if (line.compare(0, 2, "; ") == 0 && !res.empty()) {
+            size_t colon = line.find(": ");
+            if (colon == string::npos) continue;
+            const string &key = line.substr(2, colon - 2);
+            const string &val = line.substr(colon + 2);
+            Query &q = res.back();
+            if (key == "site") q.site = val;
+            else if (key == "logic") q.logic = val;
+            else if (key == "result") q.result = val;
+            else if (key == "timeout") q.timeout = stoul(val);
+            else if (key == "latency") q.latency = stod(val);
+        } else if (!res.empty()) {
+            body << line << '\n';
+        }
+    }
+    finish();
+    return res;
+}
+
+string head(const Sexp &cmd) {
+    return cmd.isSexp() && cmd.childCount() > 0 && cmd.value.sexp[0].isString() ? cmd.value.sexp[0].value.str : "";
+}
+
+double millisSince(const chrono::steady_clock::time_point &start) {
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() / 1e3;
+}
+
+/**
+ * Converts SMT-LIB2 terms as written by SmtCapture to yices terms.
+ */
+class YicesConverter {
+
+public:
+    term_t declare(const string &name, const string &sort) {
+        type_t type = sort == "Bool" ? yices_bool_type() : sort == "Int" ? yices_int_type() : yices_real_type();
+        term_t res = yices_new_uninterpreted_term(type);
+        vars[name] = res;
+        return res;
+    }
+
+    term_t convert(const Sexp &e) {
+        if (e.isString()) {
+            const string &s = e.value.str;
+            if (s == "true") return yices_true();
+            if (s == "false") return yices_false();
+            if (isdigit(static_cast<unsigned char>(s[0]))) return check(yices_parse_rational(s.c_str()));
+            auto it = vars.find(s);
+            if (it == vars.end()) {
+                throw invalid_argument("undeclared symbol " + s);
+            }
+            return it->second;
+        }
+        const string &op = head(e);
+        vector<term_t> args;
+        for (unsigned int i = 1; i < e.childCount(); ++i) {
+            // exponents are not converted, yices only supports constant ones
+            if (op == "^") break;
+            args.push_back(convert(e.value.sexp[i]));
+        }
+        if (op == "and") return check(yices_and(args.size(), &args[0]));
+        if (op == "or") return check(yices_or(args.size(), &args[0]));
+        if (op == "not") return check(yices_not(args[0]));
+        if (op == "=") return check(yices_eq(args[0], args[1]));
+        if (op == "distinct") return check(yices_distinct(args.size(), &args[0]));
+        if (op == "<") return check(yices_arith_lt_atom(args[0], args[1]));
+        if (op == "<=") return check(yices_arith_leq_atom(args[0], args[1]));
+        if (op == ">") return check(yices_arith_gt_atom(args[0], args[1]));
+        if (op == ">=") return check(yices_arith_geq_atom(args[0], args[1]));
+        if (op == "+") return check(yices_sum(args.size(), &args[0]));
+        if (op == "*") return check(yices_product(args.size(), &args[0]));
+        if (op == "-") return check(args.size() == 1 ? yices_neg(args[0]) : yices_sub(args[0], args[1]));
+        if (op == "/") return check(yices_division(args[0], args[1]));
+        if (op == "^") {
+            const Sexp &exp = e.value.sexp[2];
+            if (!exp.isString() || !all_of(exp.value.str.begin(), exp.value.str.end(), ::isdigit)) {
+                throw invalid_argument("non-constant exponent " + exp.toString());
+            }
+            return check(yices_power(convert(e.value.sexp[1]), stoul(exp.value.str)));
+        }
+        throw invalid_argument("unsupported operator " + op);
+    }
+
+private:
+    map<string, term_t> vars;
+
+    static term_t check(term_t t) {
+        if (t < 0) {
+            char *msg = yices_error_string();
+            string err(msg);
+            yices_free_string(msg);
+            throw invalid_argument(err);
+        }
+        return t;
+    }
+
+};
+
+string toString(smt_status_t status) {
+    switch (status) {
+    case STATUS_SAT: return "sat";
+    case STATUS_UNSAT: return "unsat";
+    default: return "unknown";
+    }
+}
+
+Run runYices(const Query &q, unsigned int timeout) {
+    ctx_config_t *config = yices_new_config();
+    if (q.logic == "QF_NA") {
+        yices_set_config(config, "solver-type", "mcsat");
+    }
+    context_t *ctx = yices_new_context(config);
+    YicesConverter converter;
+    vector<term_t> assumptions;
+    auto start = chrono::steady_clock::now();
+    smt_status_t status = STATUS_UNKNOWN;
+    try {
+        for (const Sexp &cmd: q.commands) {
+            const string &h = head(cmd);
+            if (h == "declare-fun") {
+                converter.declare(cmd.value.sexp[1].value.str, cmd.value.sexp[3].value.str);
+            } else if (h == "assert") {
+                yices_assert_formula(ctx, converter.convert(cmd.value.sexp[1]));
+            } else if (h == "check-sat-assuming") {
+                for (const Sexp &a: cmd.value.sexp[1].value.sexp) {
+                    assumptions.push_back(converter.convert(a));
+                }
+            }
+        }
+        Watchdog::Ticket ticket = Watchdog::arm(chrono::milliseconds(timeout), [ctx]{yices_stop_search(ctx);});
+        status = assumptions.empty() ?
+                    yices_check_context(ctx, nullptr) :
+                    yices_check_context_with_assumptions(ctx, nullptr, assumptions.size(), &assumptions[0]);
+        Watchdog::disarm(ticket);
+    } catch (const invalid_argument &e) {
+        // e.g. exponentials, which yices does not support
+        status = STATUS_UNKNOWN;
+    }
+    double latency = millisSince(start);
+    yices_free_context(ctx);
+    yices_free_config(config);
+    return {toString(status), latency};
+}
+
+Run runZ3(const Query &q, unsigned int timeout) {
+    z3::context ctx;
+    z3::solver solver(ctx);
+    z3::params params(ctx);
+    params.set(":timeout", timeout);
+    solver.set(params);
+    // z3 parses declarations and assertions by itself, check-sat(-assuming) is issued via the API
+    stringstream script;
+    vector<string> assumptions;
+    for (const Sexp &cmd: q.commands) {
+        const string &h = head(cmd);
+        if (h == "declare-fun" || h == "assert") {
+            script << Sexp(vector<Sexp>{cmd}).toString() << '\n';
+        } else if (h == "check-sat-assuming") {
+            for (const Sexp &a: cmd.value.sexp[1].value.sexp) {
+                assumptions.push_back(a.value.str);
+            }
+        }
+    }
+    auto start = chrono::steady_clock::now();
+    z3::check_result res = z3::unknown;
+    try {
+        solver.from_string(script.str().c_str());
+        z3::expr_vector as(ctx);
+        for (const string &a: assumptions) {
+            as.push_back(ctx.bool_const(a.c_str()));
+        }
+        res = as.empty() ? solver.check() : solver.check(as);
+    } catch (const z3::exception &e) {
+        res = z3::unknown;
+    }
+    double latency = millisSince(start);
+    switch (res) {
+    case z3::sat: return {"sat", latency};
+    case z3::unsat: return {"unsat", latency};
+    default: return {"unknown", latency};
+    }
+}
+
+void add(Stats &stats, const Run &run, const string &expected) {
+    stats.latencies.push_back(run.latency);
+    stats.results[run.result]++;
+    if (run.result != "unknown" && expected != "unknown" && run.result != expected) {
+        stats.conflicts++;
+    }
+}
+
+double percentile(const vector<double> &sorted, double p) {
+    return sorted[min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+}
+
+void print(const string &name, Stats stats) {
+    vector<double> &ls = stats.latencies;
+    sort(ls.begin(), ls.end());
+    double sum = 0;
+    for (double l: ls) {
+        sum += l;
+    }
+    cout << "  " << setw(8) << left << name << right << fixed << setprecision(2)
+         << " sat " << stats.results["sat"] << ", unsat " << stats.results["unsat"] << ", unknown " << stats.results["unknown"];
+    if (stats.conflicts > 0) {
+        cout << ", CONFLICTING " << stats.conflicts;
+    }
+    cout << endl;
+    cout << "           latency (ms): total " << sum << ", mean " << sum / ls.size()
+         << ", min " << ls.front() << ", median " << percentile(ls, 0.5) << ", p90 " << percentile(ls, 0.9)
+         << ", p99 " << percentile(ls, 0.99) << ", max " << ls.back() << endl;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int timeout = 0;
+    bool yices = true;
+    bool z3 = true;
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp("--timeout", argv[i]) == 0 && i + 1 < argc) {
+            timeout = atoi(argv[++i]);
+        } else if (strcmp("--solver", argv[i]) == 0 && i + 1 < argc) {
+            string solver = argv[++i];
+            yices = solver == "yices";
+            z3 = solver == "z3";
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        cout << "Usage: " << argv[0] << " [--timeout <ms>] [--solver <yices|z3>] <file>..." << endl;
+        return 1;
+    }
+
+    yices_init();
+    map<string, map<string, Stats>> stats;
+    unsigned long count = 0;
+    for (const string &file: files) {
+        for (const Query &q: load(file)) {
+            unsigned int t = timeout > 0 ? timeout : q.timeout;
+            map<string, Stats> &site = stats[q.site];
+            add(site["captured"], {q.result, q.latency}, q.result);
+            if (yices) {
+                add(site["yices"], runYices(q, t), q.result);
+            }
+            if (z3) {
+                add(site["z3"], runZ3(q, t), q.result);
+            }
+            ++count;
+        }
+    }
+    yices_exit();
+
+    cout << count << " queries" << endl;
+    for (const auto &site: stats) {
+        cout << site.first << ": " << site.second.at("captured").latencies.size() << " queries" << endl;
+        for (const auto &solver: site.second) {
+            print(solver.first, solver.second);
+        }
+    }
+    return 0;
+}
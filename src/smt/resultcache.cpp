@@ -0,0 +1,167 @@
+#include "resultcache.hpp"
+#include "../config.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+std::mutex ResultCache::mutex;
+
+std::atomic_ulong ResultCache::hits(0);
+std::atomic_ulong ResultCache::misses(0);
+
+namespace {
+
+    // the i-th canonical variable of the given type
+    Var canonicalVar(unsigned int i, Expr::Type type) {
+        static std::vector<Var> ints;
+        static std::vector<Var> rationals;
+        static std::mutex mutex;
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<Var> &vars = type == Expr::Int ? ints : rationals;
+        while (vars.size() <= i) {
+            std::string prefix = type == Expr::Int ? "_i" : "_r";
+            vars.push_back(Var(prefix + std::to_string(vars.size())));
+        }
+        return vars[i];
+    }
+
+    /**
+     * Orders the given operands by their shapes and appends their variables to vars in this order.
+     * The sort is stable, so operands with the same shape are visited in their original order.
+     * @return the shapes of the operands, in this order
+     */
+    std::string orderedShapes(const std::vector<std::pair<std::string, std::vector<Var>>> &operands, std::vector<Var> &vars) {
+        std::vector<unsigned int> idx(operands.size());
+        for (unsigned int i = 0; i < idx.size(); ++i) {
+            idx[i] = i;
+        }
+        std::stable_sort(idx.begin(), idx.end(), [&](unsigned int i, unsigned int j) {
+            return operands[i].first < operands[j].first;
+        });
+        std::string res;
+        for (unsigned int i: idx) {
+            res += operands[i].first + ",";
+            vars.insert(vars.end(), operands[i].second.begin(), operands[i].second.end());
+        }
+        return res;
+    }
+
+    /**
+     * The shape of a term is its structure without variable names (only their types are kept),
+     * where the operands of sums and products are sorted by their shapes. Hence, the shape does not
+     * depend on the names of the variables or on GiNaC's term order (which depends on the serial
+     * numbers of the variables).
+     * The variables of e are appended to vars in the order of their occurrence in the shape.
+     */
+    std::string termShape(const Expr &e, const VariableManager &varMan, std::vector<Var> &vars) {
+        if (e.isVar()) {
+            vars.push_back(e.toVar());
+            return varMan.getType(e.toVar()) == Expr::Int ? "i" : "r";
+        }
+        if (e.arity() == 0) {
+            std::stringstream ss;
+            ss << e;
+            return ss.str();
+        }
+        std::vector<std::pair<std::string, std::vector<Var>>> operands;
+        for (unsigned int i = 0; i < e.arity(); ++i) {
+            operands.emplace_back();
+            operands.back().first = termShape(e.op(i), varMan, operands.back().second);
+        }
+        if (e.isAdd() || e.isMul()) {
+            return (e.isAdd() ? "+(" : "*(") + orderedShapes(operands, vars) + ")";
+        }
+        // the order of the operands matters (e.g., for powers)
+        std::string res = "f(";
+        for (const auto &op: operands) {
+            res += op.first + ",";
+            vars.insert(vars.end(), op.second.begin(), op.second.end());
+        }
+        return res + ")";
+    }
+
+    // like termShape, but for formulas (the children of junctions are sorted by their shapes)
+    std::string formulaShape(const BoolExpr e, const VariableManager &varMan, std::vector<Var> &vars) {
+        if (e->getLit()) {
+            const Rel &rel = e->getLit().get();
+            std::string lhs = termShape(rel.lhs(), varMan, vars);
+            std::string rhs = termShape(rel.rhs(), varMan, vars);
+            return lhs + std::to_string(rel.relOp()) + rhs;
+        }
+        if (e->getConst()) {
+            return "c" + std::to_string(e->getConst().get());
+        }
+        std::vector<std::pair<std::string, std::vector<Var>>> children;
+        for (const BoolExpr &c: e->getChildren()) {
+            children.emplace_back();
+            children.back().first = formulaShape(c, varMan, children.back().second);
+        }
+        return (e->isAnd() ? "&(" : "|(") + orderedShapes(children, vars) + ")";
+    }
+
+}
+
+ResultCache::Key::Key(const BoolExpr e, Smt::Logic logic, const VariableManager &varMan): logic(logic) {
+    std::vector<Var> order;
+    formulaShape(e, varMan, order);
+    Subs renaming;
+    unsigned int ints = 0;
+    unsigned int rationals = 0;
+    for (const Var &x: order) {
+        if (!renaming.contains(x)) {
+            Expr::Type type = varMan.getType(x);
+            renaming.put(x, canonicalVar(type == Expr::Int ? ints++ : rationals++, type));
+        }
+    }
+    canonical = e->subs(renaming);
+}
+
+bool ResultCache::Key::operator==(const Key &that) const {
+    return logic == that.logic && canonical == that.canonical;
+}
+
+size_t ResultCache::Key::hash() const {
+    return 31 * canonical->hash() + logic;
+}
+
+size_t ResultCache::KeyHash::operator()(const Key &key) const {
+    return key.hash();
+}
+
+LruCache<ResultCache::Key, ResultCache::Entry, ResultCache::KeyHash>& ResultCache::cache() {
+    static LruCache<Key, Entry, KeyHash> cache(Config::Smt::ResultCacheSize);
+    return cache;
+}
+
+option<Smt::Result> ResultCache::lookup(const Key &key, unsigned int timeout) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const Entry *entry = cache().get(key);
+    // an unknown result might turn into sat or unsat if we spend more time
+    if (!entry || (entry->res == Smt::Unknown && entry->timeout < timeout)) {
+        ++misses;
+        return {};
+    }
+    ++hits;
+    return entry->res;
+}
+
+void ResultCache::store(const Key &key, Smt::Result res, unsigned int timeout) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache().put(key, {res, timeout});
+}
+
+void ResultCache::printStatistics(std::ostream &s) {
+    unsigned long h = hits;
+    unsigned long m = misses;
+    unsigned long evictions;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        evictions = cache().getEvictions();
+    }
+    s << "SMT result cache: " << h << " hits, " << m << " misses, " << evictions << " evictions";
+    if (h + m > 0) {
+        s << " (hit rate " << std::fixed << std::setprecision(1) << 100.0 * h / (h + m) << "%)";
+    }
+    s << std::endl;
+}
@@ -0,0 +1,68 @@
+#ifndef RESULTCACHE_HPP
+#define RESULTCACHE_HPP
+
+#include "smt.hpp"
+#include "../util/lrucache.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+
+/**
+ * A bounded (LRU) memo table for satisfiability checks of closed formulas.
+ *
+ * Formulas are stored in a canonical form where all variables are renamed to
+ * canonical variables (respecting their types), so that the same guard is recognized
+ * even if it is checked with respect to a different VariableManager or after
+ * variables have been renamed consistently (e.g., by chaining, which introduces fresh variables).
+ * Variables are numbered in the order of their first occurrence in a traversal that visits
+ * subformulas and subterms sorted by their structure, ignoring the names of the variables.
+ *
+ * Unknown results are stored together with the timeout they were obtained with
+ * and are only reused for queries with the same or a smaller timeout.
+ */
+class ResultCache {
+
+public:
+
+    class Key {
+
+    public:
+        Key(const BoolExpr e, Smt::Logic logic, const VariableManager &varMan);
+        bool operator==(const Key &that) const;
+        size_t hash() const;
+
+    private:
+        BoolExpr canonical;
+        Smt::Logic logic;
+    };
+
+    static option<Smt::Result> lookup(const Key &key, unsigned int timeout);
+
+    static void store(const Key &key, Smt::Result res, unsigned int timeout);
+
+    /**
+     * Prints the number of cache hits, misses and evictions (for all threads) to the given stream.
+     */
+    static void printStatistics(std::ostream &s);
+
+private:
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        Smt::Result res;
+        unsigned int timeout;
+    };
+
+    static LruCache<Key, Entry, KeyHash>& cache();
+    static std::mutex mutex;
+
+    static std::atomic_ulong hits;
+    static std::atomic_ulong misses;
+
+};
+
+#endif // RESULTCACHE_HPP
@@ -1,28 +1,138 @@
 #include "smt.hpp"
-#include "smtfactory.hpp"
+#include "solverpool.hpp"
+#include "resultcache.hpp"
+#include "linearpresolver.hpp"
+#include "modelcache.hpp"
+#include "smtcapture.hpp"
+#include "smtstatistics.hpp"
+#include "../util/budget.hpp"
+
+#include <chrono>
+
+Smt::Smt(const VariableManager &varMan, Logic logic): varMan(varMan), logic(logic) {}
 
 Smt::~Smt() {}
 
+void Smt::add(const BoolExpr e) {
+    if (SmtCapture::enabled()) {
+        assertions.back().push_back(e);
+    }
+}
+
 void Smt::add(const Rel &e) {
     return this->add(buildLit(e));
 }
 
 Smt::Result Smt::check(const BoolExpr e, const VariableManager &varMan) {
-    std::unique_ptr<Smt> s = SmtFactory::solver(Smt::chooseLogic(BoolExprSet{e}), varMan);
-    s->add(e);
-    return s->check();
+    return check(std::vector<BoolExpr>{e}, varMan)[0];
+}
+
+std::vector<Smt::Result> Smt::check(const std::vector<BoolExpr> &es, const VariableManager &varMan) {
+    unsigned int timeout = Budget::timeout(Budget::Default);
+    std::vector<Smt::Result> res(es.size(), Smt::Unknown);
+    std::vector<option<ResultCache::Key>> keys(es.size());
+    // indices of the formulas that have to be checked by a solver, per logic
+    std::vector<unsigned int> todo[3];
+    for (unsigned int i = 0; i < es.size(); ++i) {
+        Smt::Logic logic = Smt::chooseLogic(BoolExprSet{es[i]});
+        if (logic == Smt::QF_LA) {
+            const option<Smt::Result> &presolved = LinearPresolver::check(es[i], varMan);
+            if (presolved) {
+                res[i] = presolved.get();
+                continue;
+            }
+        }
+        keys[i] = ResultCache::Key(es[i], logic, varMan);
+        const option<Smt::Result> &cached = ResultCache::lookup(keys[i].get(), timeout);
+        if (cached) {
+            res[i] = cached.get();
+        } else {
+            todo[logic].push_back(i);
+        }
+    }
+    for (unsigned int l = 0; l < 3; ++l) {
+        if (todo[l].empty()) {
+            continue;
+        }
+        Smt::Logic logic = static_cast<Smt::Logic>(l);
+        // linear formulas are checked incrementally, but z3 is weaker on non-linear arithmetic in incremental mode
+        bool incremental = logic == Smt::QF_LA;
+        SolverPool::Lease s = SolverPool::acquire(logic, varMan, timeout);
+        for (unsigned int i: todo[l]) {
+            // models found for previous formulas of the batch may already be useful
+            if (ModelCache::isSat(es[i], varMan)) {
+                res[i] = Smt::Sat;
+            } else {
+                if (incremental) {
+                    s->push();
+                }
+                s->add(es[i]);
+                res[i] = s->check();
+                // yices always provides models, so they are only cached for linear queries
+                if (res[i] == Smt::Sat && logic == Smt::QF_LA) {
+                    ModelCache::add(s->model(), varMan);
+                }
+                if (incremental) {
+                    s->pop();
+                } else {
+                    s->resetSolver();
+                }
+            }
+            ResultCache::store(keys[i].get(), res[i], timeout);
+        }
+    }
+    return res;
 }
 
 bool Smt::isImplication(const BoolExpr lhs, const BoolExpr rhs, const VariableManager &varMan) {
-    std::unique_ptr<Smt> s = SmtFactory::solver(Smt::chooseLogic(BoolExprSet{lhs, rhs}), varMan);
-    s->add(lhs);
-    s->add(!rhs);
-    return s->check() == Smt::Unsat;
+    return check(lhs & !rhs, varMan) == Smt::Unsat;
 }
 
 BoolExprSet Smt::unsatCore(const BoolExprSet &assumptions, VariableManager &varMan) {
-    std::unique_ptr<Smt> solver = SmtFactory::solver(Smt::chooseLogic(assumptions), varMan);
-    return solver->_unsatCore(assumptions).second;
+    SolverPool::Lease solver = SolverPool::acquire(Smt::chooseLogic(assumptions), varMan);
+    return solver->unsatCore(assumptions);
+}
+
+Smt::Result Smt::check() {
+    bool capture = SmtCapture::enabled();
+    if (!capture && !Config::Output::Statistics) {
+        return _check();
+    }
+    auto start = std::chrono::steady_clock::now();
+    Smt::Result res = _check();
+    auto latency = std::chrono::steady_clock::now() - start;
+    if (Config::Output::Statistics) {
+        SmtStatistics::record(SmtCallSite::current(), logic, res, latency, timeout);
+    }
+    if (capture) {
+        SmtCapture::record(assertions, {}, timeout, res, latency, varMan);
+    }
+    return res;
+}
+
+BoolExprSet Smt::unsatCore(const BoolExprSet &assumptions) {
+    bool capture = SmtCapture::enabled();
+    if (!capture && !Config::Output::Statistics) {
+        return _unsatCore(assumptions).second;
+    }
+    auto start = std::chrono::steady_clock::now();
+    const std::pair<Smt::Result, BoolExprSet> &res = _unsatCore(assumptions);
+    auto latency = std::chrono::steady_clock::now() - start;
+    if (Config::Output::Statistics) {
+        SmtStatistics::record(SmtCallSite::current(), logic, res.first, latency, timeout);
+    }
+    if (capture) {
+        SmtCapture::record(assertions, assumptions, timeout, res.first, latency, varMan);
+    }
+    return res.second;
+}
+
+Smt::Result Smt::delegateCheck(Smt &solver) {
+    return solver._check();
+}
+
+std::pair<Smt::Result, BoolExprSet> Smt::delegateUnsatCore(Smt &solver, const BoolExprSet &assumptions) {
+    return solver._unsatCore(assumptions);
 }
 
 Smt::Logic Smt::chooseLogic(const std::vector<BoolExpr> &xs, const std::vector<Subs> &up) {
@@ -67,8 +177,17 @@ void Smt::popAll() {
 
 void Smt::pop() {
     pushCount--;
+    if (assertions.size() > 1) {
+        assertions.pop_back();
+    }
 }
 
 void Smt::push() {
     pushCount++;
+    assertions.emplace_back();
+}
+
+void Smt::resetSolver() {
+    pushCount = 0;
+    assertions = {{}};
 }
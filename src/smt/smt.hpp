@@ -5,9 +5,11 @@
 #include "../expr/boolexpr.hpp"
 #include "../its/variablemanager.hpp"
 #include "model.hpp"
+#include "../config.hpp"
 
 class Smt
 {
+
 public:
 
     enum Result {Sat, Unknown, Unsat};
@@ -17,14 +19,31 @@ public:
     void add(const Rel &e);
     virtual void push() = 0;
     virtual void pop() = 0;
-    virtual Result check() = 0;
+    /**
+     * Checks satisfiability of the formulas that have been added to this solver.
+     * If Config::Smt::CaptureFile is set, the query is appended to it (see SmtCapture).
+     */
+    Result check();
     virtual Model model() = 0;
     virtual void setTimeout(unsigned int timeout) = 0;
     virtual void enableModels() = 0;
     virtual void resetSolver() = 0;
+    // aborts a running check, may be called from another thread
+    virtual void interrupt() = 0;
     virtual ~Smt();
 
+    /**
+     * Computes an unsat core of the given assumptions wrt. the formulas that have been added to this solver.
+     * @return the empty set if the assumptions are satisfiable or the solver gives up
+     */
+    BoolExprSet unsatCore(const BoolExprSet &assumptions);
+
     static Smt::Result check(const BoolExpr e, const VariableManager &varMan);
+    /**
+     * Checks many formulas at once, such that at most one solver per logic is used for the whole batch.
+     * @return the results in the same order as the given formulas
+     */
+    static std::vector<Smt::Result> check(const std::vector<BoolExpr> &es, const VariableManager &varMan);
     static bool isImplication(const BoolExpr lhs, const BoolExpr rhs, const VariableManager &varMan);
     static BoolExprSet unsatCore(const BoolExprSet &assumptions, VariableManager &varMan);
     static Logic chooseLogic(const std::vector<BoolExpr> &xs, const std::vector<Subs> &up = {});
@@ -57,12 +76,26 @@ public:
 
 protected:
 
+    Smt(const VariableManager &varMan, Logic logic);
+
+    virtual Result _check() = 0;
     virtual std::pair<Result, BoolExprSet> _unsatCore(const BoolExprSet &assumptions) = 0;
 
+    // allow solvers that delegate to other solvers (see RacingSolver) to call their hooks
+    static Result delegateCheck(Smt &solver);
+    static std::pair<Result, BoolExprSet> delegateUnsatCore(Smt &solver, const BoolExprSet &assumptions);
+
+    const VariableManager &varMan;
+    // the logic this solver has been created for (see SmtFactory)
+    const Logic logic;
+    unsigned int timeout = Config::Smt::DefaultTimeout;
+    int pushCount = 0;
 
 private:
 
-    int pushCount = 0;
+    // the formulas that have been added to this solver, one frame per push (only maintained for SmtCapture)
+    std::vector<std::vector<BoolExpr>> assertions = {{}};
+
 };
 
 #endif // SMT_H
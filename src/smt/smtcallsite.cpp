@@ -0,0 +1,36 @@
+#include "smtcallsite.hpp"
+
+thread_local SmtCallSite::Site SmtCallSite::active = SmtCallSite::Other;
+
+SmtCallSite::SmtCallSite(Site site): previous(active) {
+    active = site;
+}
+
+SmtCallSite::~SmtCallSite() {
+    active = previous;
+}
+
+SmtCallSite::Site SmtCallSite::current() {
+    return active;
+}
+
+std::string SmtCallSite::name(Site site) {
+    switch (site) {
+    case Other: return "other";
+    case Chaining: return "chaining";
+    case Acceleration: return "acceleration";
+    case Limit: return "limit";
+    case Pruning: return "pruning";
+    }
+    return "other";
+}
+
+SmtCallSite::Site SmtCallSite::fromName(const std::string &name) {
+    for (unsigned int i = 0; i < Count; ++i) {
+        Site site = static_cast<Site>(i);
+        if (SmtCallSite::name(site) == name) {
+            return site;
+        }
+    }
+    return Other;
+}
@@ -0,0 +1,36 @@
+#ifndef SMTCALLSITE_HPP
+#define SMTCALLSITE_HPP
+
+#include <string>
+
+/**
+ * Identifies the part of the analysis that issues SMT queries, e.g. to attribute captured queries.
+ *
+ * An SmtCallSite object marks the current thread as being inside the given call site until it is
+ * destructed. Call sites may be nested, then the innermost one is reported.
+ */
+class SmtCallSite {
+
+public:
+    enum Site {Other, Chaining, Acceleration, Limit, Pruning};
+    static const unsigned int Count = 5;
+
+    explicit SmtCallSite(Site site);
+    ~SmtCallSite();
+
+    SmtCallSite(const SmtCallSite &that) = delete;
+    SmtCallSite& operator=(const SmtCallSite &that) = delete;
+
+    static Site current();
+    static std::string name(Site site);
+    // returns Other for unknown names
+    static Site fromName(const std::string &name);
+
+private:
+    Site previous;
+
+    static thread_local Site active;
+
+};
+
+#endif // SMTCALLSITE_HPP
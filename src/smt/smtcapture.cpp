@@ -0,0 +1,237 @@
+#include "smtcapture.hpp"
+#include "../its/smt2Parser/sexpresso/sexpresso.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+using namespace sexpresso;
+
+namespace {
+
+    std::mutex mutex;
+    unsigned long queries = 0;
+
+    /**
+     * Converts LoAT's formulas to SMT-LIB2. Variable names are sanitized and made unique, since LoAT's
+     * variable names may contain arbitrary characters and different variables may have the same name.
+     */
+    class Printer {
+
+    public:
+        Printer(const VariableManager &varMan): varMan(varMan) {}
+
+        Sexp convert(const BoolExpr e) {
+            if (e->getLit()) {
+                return convert(e->getLit().get());
+            } else if (e->getConst()) {
+                int id = e->getConst().get();
+                Sexp c("_b" + std::to_string(id < 0 ? -id : id));
+                consts.insert(c.toString());
+                return id < 0 ? Sexp({Sexp("not"), c}) : c;
+            }
+            const BoolExprSet &children = e->getChildren();
+            if (children.empty()) {
+                return Sexp(e->isAnd() ? "true" : "false");
+            } else if (children.size() == 1) {
+                return convert(*children.begin());
+            }
+            Sexp res(e->isAnd() ? "and" : "or");
+            for (const BoolExpr &c: children) {
+                res.addChild(convert(c));
+            }
+            return res;
+        }
+
+        // declarations of all variables that occurred in converted formulas so far
+        std::vector<Sexp> declarations() const {
+            std::vector<Sexp> res;
+            for (const auto &p: vars) {
+                const std::string &sort = varMan.getType(p.first) == Expr::Int ? "Int" : "Real";
+                res.push_back(Sexp({Sexp("declare-fun"), Sexp(p.second), Sexp(), Sexp(sort)}));
+            }
+            for (const std::string &c: consts) {
+                res.push_back(Sexp({Sexp("declare-fun"), Sexp(c), Sexp(), Sexp("Bool")}));
+            }
+            return res;
+        }
+
+    private:
+        Sexp convert(const Rel &rel) {
+            std::string op;
+            switch (rel.relOp()) {
+            case Rel::eq: op = "="; break;
+            case Rel::neq: op = "distinct"; break;
+            case Rel::lt: op = "<"; break;
+            case Rel::leq: op = "<="; break;
+            case Rel::gt: op = ">"; break;
+            case Rel::geq: op = ">="; break;
+            }
+            return Sexp({Sexp(op), convert(rel.lhs()), convert(rel.rhs())});
+        }
+
+        Sexp convert(const Expr &e) {
+            if (e.isAdd() || e.isMul()) {
+                Sexp res(e.isAdd() ? "+" : "*");
+                for (unsigned int i = 0; i < e.arity(); ++i) {
+                    res.addChild(convert(e.op(i)));
+                }
+                return res;
+            } else if (e.isPow()) {
+                // as in ExprToSmt, small natural powers are written as products
+                if (e.op(1).isRationalConstant()) {
+                    const GiNaC::numeric &num = e.op(1).toNum();
+                    if (num.is_integer() && num.is_positive() && num.to_long() <= Config::Smt::MaxExponentWithoutPow) {
+                        Sexp res("*");
+                        const Sexp &base = convert(e.op(0));
+                        for (int i = 0; i < num.to_int(); ++i) {
+                            res.addChild(base);
+                        }
+                        return num.to_int() == 1 ? base : res;
+                    }
+                }
+                return Sexp({Sexp("^"), convert(e.op(0)), convert(e.op(1))});
+            } else if (e.isRationalConstant()) {
+                return convert(e.toNum());
+            } else if (e.isVar()) {
+                return Sexp(name(e.toVar()));
+            }
+            std::stringstream ss;
+            ss << "cannot capture term " << e;
+            throw std::invalid_argument(ss.str());
+        }
+
+        Sexp convert(const GiNaC::numeric &num) {
+            if (num.is_negative()) {
+                return Sexp({Sexp("-"), convert(-num)});
+            } else if (!num.is_integer()) {
+                return Sexp({Sexp("/"), convert(num.numer()), convert(num.denom())});
+            }
+            std::stringstream ss;
+            ss << num;
+            return Sexp(ss.str());
+        }
+
+        std::string name(const Var &x) {
+            auto it = vars.find(x);
+            if (it != vars.end()) {
+                return it->second;
+            }
+            std::string res;
+            for (char c: x.get_name()) {
+                res += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+            }
+            // names starting with an underscore are reserved for boolean variables
+            if (res.empty() || !std::isalpha(static_cast<unsigned char>(res[0]))) {
+                res = "v" + res;
+            }
+            std::string unique = res;
+            for (unsigned int i = 1; usedNames.count(unique) > 0; ++i) {
+                unique = res + "_" + std::to_string(i);
+            }
+            usedNames.insert(unique);
+            vars.emplace(x, unique);
+            return unique;
+        }
+
+        const VariableManager &varMan;
+        VarMap<std::string> vars;
+        std::set<std::string> usedNames;
+        std::set<std::string> consts;
+
+    };
+
+    std::ofstream& file() {
+        static std::ofstream file(Config::Smt::CaptureFile, std::ios::app);
+        return file;
+    }
+
+}
+
+bool SmtCapture::enabled() {
+    return !Config::Smt::CaptureFile.empty();
+}
+
+std::string SmtCapture::logicName(Smt::Logic logic) {
+    switch (logic) {
+    case Smt::QF_LA: return "QF_LA";
+    case Smt::QF_NA: return "QF_NA";
+    case Smt::QF_ENA: return "QF_ENA";
+    }
+    throw std::invalid_argument("unknown logic");
+}
+
+std::string SmtCapture::smtLibLogic(Smt::Logic logic) {
+    switch (logic) {
+    case Smt::QF_LA: return "QF_LIRA";
+    case Smt::QF_NA: return "QF_NIRA";
+    case Smt::QF_ENA: return "ALL";
+    }
+    throw std::invalid_argument("unknown logic");
+}
+
+std::string SmtCapture::resultName(Smt::Result res) {
+    switch (res) {
+    case Smt::Sat: return "sat";
+    case Smt::Unsat: return "unsat";
+    case Smt::Unknown: return "unknown";
+    }
+    throw std::invalid_argument("unknown result");
+}
+
+void SmtCapture::record(const std::vector<std::vector<BoolExpr>> &assertions,
+                        const BoolExprSet &assumptions,
+                        unsigned int timeout,
+                        Smt::Result res,
+                        std::chrono::steady_clock::duration latency,
+                        const VariableManager &varMan) {
+    std::vector<BoolExpr> formulas;
+    for (const std::vector<BoolExpr> &frame: assertions) {
+        formulas.insert(formulas.end(), frame.begin(), frame.end());
+    }
+    formulas.insert(formulas.end(), assumptions.begin(), assumptions.end());
+    Smt::Logic logic = Smt::chooseLogic(formulas);
+
+    // convert before taking the lock, the conversion may be costly
+    Printer printer(varMan);
+    std::vector<Sexp> commands;
+    for (const std::vector<BoolExpr> &frame: assertions) {
+        for (const BoolExpr &e: frame) {
+            commands.push_back(Sexp({Sexp("assert"), printer.convert(e)}));
+        }
+    }
+    if (assumptions.empty()) {
+        commands.push_back(Sexp(std::vector<Sexp>{Sexp("check-sat")}));
+    } else {
+        Sexp names;
+        unsigned int i = 0;
+        for (const BoolExpr &a: assumptions) {
+            Sexp name("_a" + std::to_string(i++));
+            commands.push_back(Sexp({Sexp("declare-fun"), name, Sexp(), Sexp("Bool")}));
+            commands.push_back(Sexp({Sexp("assert"), Sexp({Sexp("="), name, printer.convert(a)})}));
+            names.addChild(name);
+        }
+        commands.push_back(Sexp({Sexp("check-sat-assuming"), names}));
+    }
+    double millis = std::chrono::duration_cast<std::chrono::microseconds>(latency).count() / 1e3;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::ofstream &s = file();
+    s << "; query " << queries++ << std::endl;
+    s << "; site: " << SmtCallSite::name(SmtCallSite::current()) << std::endl;
+    s << "; logic: " << logicName(logic) << std::endl;
+    s << "; timeout: " << timeout << std::endl;
+    s << "; result: " << resultName(res) << std::endl;
+    s << "; latency: " << std::fixed << std::setprecision(3) << millis << std::endl;
+    s << "(set-logic " << smtLibLogic(logic) << ")" << std::endl;
+    // toString() omits the parentheses of the outermost list
+    for (const Sexp &d: printer.declarations()) {
+        s << Sexp(std::vector<Sexp>{d}).toString() << std::endl;
+    }
+    for (const Sexp &c: commands) {
+        s << Sexp(std::vector<Sexp>{c}).toString() << std::endl;
+    }
+    s << "(reset)" << std::endl;
+}
@@ -0,0 +1,44 @@
+#ifndef SMTCAPTURE_HPP
+#define SMTCAPTURE_HPP
+
+#include "smt.hpp"
+#include "smtcallsite.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Writes SMT queries to the file given by Config::Smt::CaptureFile in SMT-LIB2 format,
+ * e.g. to compare solvers or solver versions on the queries that actually arise in practice.
+ *
+ * Each query is preceded by comments with its call site (see SmtCallSite), logic, timeout (in ms),
+ * result and latency (in ms), and terminated by (reset). Unsat core queries are written as
+ * check-sat-assuming, where each assumption is named by a fresh boolean variable.
+ * The resulting files can be re-run with the loat-replay tool.
+ */
+namespace SmtCapture {
+
+    bool enabled();
+
+    /**
+     * Appends a query to the capture file.
+     * @param assertions the formulas that have been added to the solver, one frame per push
+     * @param assumptions the assumptions of an unsat core query (empty for ordinary queries)
+     */
+    void record(const std::vector<std::vector<BoolExpr>> &assertions,
+                const BoolExprSet &assumptions,
+                unsigned int timeout,
+                Smt::Result res,
+                std::chrono::steady_clock::duration latency,
+                const VariableManager &varMan);
+
+    std::string logicName(Smt::Logic logic);
+    std::string resultName(Smt::Result res);
+
+    // SMT-LIB2 logic that is used for queries of the given logic (variables may be integers or reals)
+    std::string smtLibLogic(Smt::Logic logic);
+
+}
+
+#endif // SMTCAPTURE_HPP
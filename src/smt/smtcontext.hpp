@@ -21,6 +21,8 @@
 #include "../util/option.hpp"
 #include "../expr/expression.hpp"
 #include "../expr/rel.hpp"
+#include "../util/lrucache.hpp"
+#include "../config.hpp"
 
 #include <map>
 
@@ -29,6 +31,11 @@ class SmtContext {
 
 public:
 
+    /**
+     * @param conversionCacheSize the maximal number of entries of each conversion cache (see getCachedTerm)
+     */
+    explicit SmtContext(unsigned conversionCacheSize): termCache(conversionCacheSize), litCache(conversionCacheSize) {}
+
     virtual EXPR getInt(long val) = 0;
     virtual EXPR getReal(long num, long denom) = 0;
     virtual EXPR pow(const EXPR &base, const EXPR &exp) = 0;
@@ -123,6 +130,35 @@ public:
         return negated ? negate(res.get()) : res.get();
     }
 
+    /**
+     * Conversion results for subterms and literals, so that terms which occur in many formulas
+     * (e.g., guards that are checked again and again after chaining) are only converted once.
+     * If a cache is full, its least recently used entry is evicted (nothing is cached if its size is 0).
+     */
+    option<EXPR> getCachedTerm(const Expr &e) {
+        const EXPR *res = termCache.get(e);
+        if (res) {
+            return *res;
+        }
+        return {};
+    }
+
+    void cacheTerm(const Expr &e, const EXPR &res) {
+        termCache.put(e, res);
+    }
+
+    option<EXPR> getCachedLit(const Rel &rel) {
+        const EXPR *res = litCache.get(rel);
+        if (res) {
+            return *res;
+        }
+        return {};
+    }
+
+    void cacheLit(const Rel &rel, const EXPR &res) {
+        litCache.put(rel, res);
+    }
+
     virtual ~SmtContext() {}
 
     void reset() {
@@ -130,6 +166,8 @@ public:
         nameMap.clear();
         usedNames.clear();
         constMap.clear();
+        termCache.clear();
+        litCache.clear();
     }
 
 protected:
@@ -151,11 +189,33 @@ protected:
     virtual EXPR buildVar(const std::string &basename, Expr::Type type) = 0;
     virtual EXPR buildConst(unsigned int id) = 0;
 
+private:
+
+    struct TermHash {
+        size_t operator()(const Expr &e) const {
+            return e.hash();
+        }
+    };
+
+    struct TermEqual {
+        bool operator()(const Expr &x, const Expr &y) const {
+            return x.equals(y);
+        }
+    };
+
+    struct LitHash {
+        size_t operator()(const Rel &rel) const {
+            return rel.hash();
+        }
+    };
+
 protected:
     VarMap<EXPR> varMap;
     std::map<std::string, Var> nameMap;
     std::map<std::string, int> usedNames;
     std::map<unsigned int, EXPR> constMap;
+    LruCache<Expr, EXPR, TermHash, TermEqual> termCache;
+    LruCache<Rel, EXPR, LitHash> litCache;
 };
 
 #endif // SMTCONTEXT_H
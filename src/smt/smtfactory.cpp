@@ -3,6 +3,7 @@
 #include "z3/z3.hpp"
 #include "yices/yices.hpp"
 #include "combined_solver.hpp"
+#include "racingsolver.hpp"
 
 std::unique_ptr<Smt> SmtFactory::solver(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout) {
     std::unique_ptr<Smt> res;
@@ -12,8 +13,17 @@ std::unique_ptr<Smt> SmtFactory::solver(Smt::Logic logic, const VariableManager
         res = std::unique_ptr<Smt>(new Yices(varMan, logic));
         break;
     case Smt::QF_NA:
+        if (Config::Smt::RacePortfolio) {
+            // both solvers will be interrupted, so z3 must not share its context
+            res = std::unique_ptr<Smt>(new RacingSolver(varMan, logic,
+                      std::unique_ptr<Smt>(new Yices(varMan, Smt::QF_NA)),
+                      std::unique_ptr<Smt>(new Z3(varMan, Smt::QF_NA, false))));
+            break;
+        }
+        res = std::unique_ptr<Smt>(new Z3(varMan, logic));
+        break;
     case Smt::QF_ENA:
-        res = std::unique_ptr<Smt>(new Z3(varMan));
+        res = std::unique_ptr<Smt>(new Z3(varMan, logic));
         break;
     }
     res->setTimeout(timeout);
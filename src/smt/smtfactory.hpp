@@ -3,12 +3,13 @@
 
 #include "smt.hpp"
 #include "../config.hpp"
+#include "../util/budget.hpp"
 
 class SmtFactory {
 
 public:
-    static std::unique_ptr<Smt> solver(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout = Config::Smt::DefaultTimeout);
-    static std::unique_ptr<Smt> modelBuildingSolver(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout = Config::Smt::DefaultTimeout);
+    static std::unique_ptr<Smt> solver(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout = Budget::timeout(Budget::Default));
+    static std::unique_ptr<Smt> modelBuildingSolver(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout = Budget::timeout(Budget::Default));
 
 };
 
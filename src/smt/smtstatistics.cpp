@@ -0,0 +1,62 @@
+#include "smtstatistics.hpp"
+#include "smtcapture.hpp"
+
+#include <iomanip>
+
+const double SmtStatistics::BucketBounds[Buckets - 1] = {0.1, 1, 10, 100, 1000};
+
+// static storage is zero-initialized
+SmtStatistics::Counters SmtStatistics::counters[SmtCallSite::Count][3];
+
+void SmtStatistics::record(SmtCallSite::Site site, Smt::Logic logic, Smt::Result res, std::chrono::steady_clock::duration latency, unsigned int timeout) {
+    Counters &c = counters[site][logic];
+    unsigned long nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+    double millis = nanos / 1e6;
+    ++c.results[res];
+    if (res == Smt::Unknown && millis >= timeout) {
+        ++c.timeouts;
+    }
+    c.nanos += nanos;
+    unsigned long max = c.maxNanos;
+    while (nanos > max && !c.maxNanos.compare_exchange_weak(max, nanos));
+    unsigned int bucket = 0;
+    while (bucket < Buckets - 1 && millis >= BucketBounds[bucket]) {
+        ++bucket;
+    }
+    ++c.histogram[bucket];
+}
+
+void SmtStatistics::printStatistics(std::ostream &s) {
+    s << "SMT queries per call site and logic:" << std::endl;
+    for (unsigned int site = 0; site < SmtCallSite::Count; ++site) {
+        for (unsigned int logic = 0; logic < 3; ++logic) {
+            const Counters &c = counters[site][logic];
+            unsigned long sat = c.results[Smt::Sat];
+            unsigned long unsat = c.results[Smt::Unsat];
+            unsigned long unknown = c.results[Smt::Unknown];
+            unsigned long total = sat + unsat + unknown;
+            if (total == 0) {
+                continue;
+            }
+            double millis = c.nanos / 1e6;
+            s << "  " << SmtCallSite::name(static_cast<SmtCallSite::Site>(site))
+              << " (" << SmtCapture::logicName(static_cast<Smt::Logic>(logic)) << "): " << total << " queries, "
+              << sat << " sat, " << unsat << " unsat, " << unknown << " unknown"
+              << std::fixed << std::setprecision(1)
+              << " (" << 100.0 * unknown / total << "%, timeouts: " << c.timeouts << ")" << std::endl;
+            s << std::setprecision(2)
+              << "    time: " << millis << "ms, avg.: " << millis / total << "ms, max: " << c.maxNanos / 1e6 << "ms" << std::endl;
+            s << std::defaultfloat << "    latency histogram:";
+            for (unsigned int i = 0; i < Buckets; ++i) {
+                s << " ";
+                if (i < Buckets - 1) {
+                    s << "<" << BucketBounds[i];
+                } else {
+                    s << ">=" << BucketBounds[Buckets - 2];
+                }
+                s << "ms: " << c.histogram[i];
+            }
+            s << std::endl;
+        }
+    }
+}
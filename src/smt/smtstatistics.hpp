@@ -0,0 +1,43 @@
+#ifndef SMTSTATISTICS_HPP
+#define SMTSTATISTICS_HPP
+
+#include "smt.hpp"
+#include "smtcallsite.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+
+/**
+ * Counts results and latencies of all SMT queries (see Smt::check and Smt::unsatCore) per call site
+ * and logic. Only collected if Config::Output::Statistics is set.
+ *
+ * Queries are recorded with atomic counters, so the statistics can be updated concurrently by all
+ * threads of the analysis without locking.
+ */
+class SmtStatistics {
+
+public:
+    static void record(SmtCallSite::Site site, Smt::Logic logic, Smt::Result res, std::chrono::steady_clock::duration latency, unsigned int timeout);
+
+    static void printStatistics(std::ostream &s);
+
+private:
+    // upper bounds (in ms) of the buckets of the latency histogram, the last bucket is unbounded
+    static const unsigned int Buckets = 6;
+    static const double BucketBounds[Buckets - 1];
+
+    struct Counters {
+        std::atomic_ulong results[3];
+        // unknown results that took at least as long as the timeout
+        std::atomic_ulong timeouts;
+        std::atomic_ulong nanos;
+        std::atomic_ulong maxNanos;
+        std::atomic_ulong histogram[Buckets];
+    };
+
+    static Counters counters[SmtCallSite::Count][3];
+
+};
+
+#endif // SMTSTATISTICS_HPP
@@ -0,0 +1,84 @@
+#include "solverpool.hpp"
+#include "smtfactory.hpp"
+
+#include <chrono>
+#include <iomanip>
+
+thread_local SolverPool::Slot SolverPool::slots[3];
+
+std::atomic_ulong SolverPool::hits(0);
+std::atomic_ulong SolverPool::misses(0);
+std::atomic_ulong SolverPool::setupNanos(0);
+
+SolverPool::Lease::Lease(Smt::Logic logic, const VariableManager &varMan, std::unique_ptr<Smt> solver):
+    logic(logic), varMan(&varMan), solver(std::move(solver)) {}
+
+SolverPool::Lease::Lease(Lease &&that): logic(that.logic), varMan(that.varMan), solver(std::move(that.solver)) {}
+
+SolverPool::Lease::~Lease() {
+    if (solver) {
+        release(logic, varMan, std::move(solver));
+    }
+}
+
+Smt* SolverPool::Lease::operator->() const {
+    return solver.get();
+}
+
+Smt& SolverPool::Lease::operator*() const {
+    return *solver;
+}
+
+SolverPool::Lease SolverPool::acquire(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout) {
+    std::unique_ptr<Smt> solver;
+    Slot &slot = slots[logic];
+    // solvers hold a reference to the variable manager, so they can only be reused for the same one
+    // (the uid is never reused, unlike the address of a destroyed variable manager)
+    if (slot.solver && slot.varManUid == varMan.getUid()) {
+        solver = std::move(slot.solver);
+    } else {
+        slot.solver.reset();
+    }
+    if (solver) {
+        solver->setTimeout(timeout);
+        ++hits;
+    } else {
+        auto start = std::chrono::steady_clock::now();
+        solver = SmtFactory::solver(logic, varMan, timeout);
+        auto duration = std::chrono::steady_clock::now() - start;
+        setupNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+        ++misses;
+    }
+    return Lease(logic, varMan, std::move(solver));
+}
+
+void SolverPool::release(Smt::Logic logic, const VariableManager *varMan, std::unique_ptr<Smt> solver) {
+    Slot &slot = slots[logic];
+    // if the slot has been refilled in the meantime (nested queries), the solver is simply dropped
+    if (!slot.solver) {
+        solver->resetSolver();
+        slot.solver = std::move(solver);
+        slot.varManUid = varMan->getUid();
+    }
+}
+
+void SolverPool::clear() {
+    for (Slot &slot: slots) {
+        slot.solver.reset();
+    }
+}
+
+void SolverPool::printStatistics(std::ostream &s) {
+    unsigned long h = hits;
+    unsigned long m = misses;
+    double setupMs = setupNanos / 1e6;
+    double avgSetupMs = m > 0 ? setupMs / m : 0;
+    s << "SMT solver pool: " << h << " reused, " << m << " constructed";
+    if (h + m > 0) {
+        s << " (hit rate " << std::fixed << std::setprecision(1) << 100.0 * h / (h + m) << "%)";
+    }
+    s << std::endl;
+    s << "  setup time: " << std::fixed << std::setprecision(2) << setupMs << "ms"
+      << ", avg. per solver: " << avgSetupMs << "ms"
+      << ", est. saved: " << avgSetupMs * h << "ms" << std::endl;
+}
@@ -0,0 +1,76 @@
+#ifndef SOLVERPOOL_HPP
+#define SOLVERPOOL_HPP
+
+#include "smt.hpp"
+#include "../config.hpp"
+#include "../util/budget.hpp"
+
+#include <atomic>
+#include <ostream>
+
+/**
+ * Keeps one long-lived solver per logic and thread, so that one-shot queries
+ * (like Smt::check) do not pay for constructing and destructing a solver every time.
+ *
+ * A solver is borrowed via acquire() and handed back (after resetting it) when the
+ * returned Lease goes out of scope. If the pooled solver is already borrowed
+ * (e.g., by an enclosing query on the same thread), a fresh solver is created instead.
+ *
+ * The pooled solvers of a thread are owned by that thread and destroyed when it exits.
+ * They keep their backend alive (see Yices::exit), so before shutting down the backend,
+ * all other threads that used the pool have to be joined and clear() has to be called.
+ */
+class SolverPool {
+
+public:
+
+    class Lease {
+
+    public:
+        Lease(Smt::Logic logic, const VariableManager &varMan, std::unique_ptr<Smt> solver);
+        Lease(Lease &&that);
+        Lease(const Lease &that) = delete;
+        Lease& operator=(const Lease &that) = delete;
+        ~Lease();
+
+        Smt* operator->() const;
+        Smt& operator*() const;
+
+    private:
+        Smt::Logic logic;
+        const VariableManager *varMan;
+        std::unique_ptr<Smt> solver;
+    };
+
+    static Lease acquire(Smt::Logic logic, const VariableManager &varMan, unsigned int timeout = Budget::timeout(Budget::Default));
+
+    /**
+     * Destroys the pooled solvers of the current thread (borrowed solvers are not affected).
+     */
+    static void clear();
+
+    /**
+     * Prints the number of reused and newly constructed solvers (for all threads) to the given stream.
+     */
+    static void printStatistics(std::ostream &s);
+
+private:
+
+    static void release(Smt::Logic logic, const VariableManager *varMan, std::unique_ptr<Smt> solver);
+
+    struct Slot {
+        std::unique_ptr<Smt> solver;
+        // the VariableManager::getUid() of the variable manager the solver was created for
+        unsigned long varManUid = 0;
+    };
+
+    // one slot per logic (indexed by Smt::Logic) and thread
+    static thread_local Slot slots[3];
+
+    static std::atomic_ulong hits;
+    static std::atomic_ulong misses;
+    static std::atomic_ulong setupNanos;
+
+};
+
+#endif // SOLVERPOOL_HPP
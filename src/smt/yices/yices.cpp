@@ -2,8 +2,8 @@
 #include "../exprtosmt.hpp"
 #include "../../util/exceptions.hpp"
 #include "../smttoexpr.hpp"
+#include "../../util/watchdog.hpp"
 
-#include <future>
 #include <chrono>
 
 Yices::~Yices() {
@@ -14,7 +14,7 @@ Yices::~Yices() {
     yices_free_context(solver);
 }
 
-Yices::Yices(const VariableManager &varMan, Logic logic): ctx(YicesContext()), varMan(varMan), config(yices_new_config()) {
+Yices::Yices(const VariableManager &varMan, Logic logic): Smt(varMan, logic), ctx(YicesContext()), config(yices_new_config()) {
     if (logic == Smt::QF_NA) {
         yices_set_config(config, "solver-type", "mcsat");
     }
@@ -25,6 +25,7 @@ Yices::Yices(const VariableManager &varMan, Logic logic): ctx(YicesContext()), v
 }
 
 void Yices::add(const BoolExpr e) {
+    Smt::add(e);
     if (yices_assert_formula(solver, ExprToSmt<term_t>::convert(e, ctx, varMan)) < 0) {
         throw YicesError();
     }
@@ -40,20 +41,17 @@ void Yices::pop() {
     yices_pop(solver);
 }
 
-Smt::Result Yices::check() {
-    auto future = std::async(yices_check_context, solver, nullptr);
-    if (future.wait_for(std::chrono::milliseconds(timeout)) != std::future_status::timeout) {
-        switch (future.get()) {
-        case STATUS_SAT:
-            return Sat;
-        case STATUS_UNSAT:
-            return Unsat;
-        default:
-            return Unknown;
-        }
-    } else {
-       yices_stop_search(solver);
-       return Unknown;
+Smt::Result Yices::_check() {
+    Watchdog::Ticket ticket = Watchdog::arm(std::chrono::milliseconds(timeout), [this]{yices_stop_search(solver);});
+    smt_status_t status = yices_check_context(solver, nullptr);
+    Watchdog::disarm(ticket);
+    switch (status) {
+    case STATUS_SAT:
+        return Sat;
+    case STATUS_UNSAT:
+        return Unsat;
+    default:
+        return Unknown;
     }
 }
 
@@ -62,17 +60,20 @@ Model Yices::model() {
         return Model({}, {});
     }
     model_t *m = yices_get_model(solver, true);
+    // the context may know variables from previous queries (see SolverPool), which are not part of the model
     VarMap<GiNaC::numeric> vars;
     for (const auto &p: ctx.getSymbolMap()) {
-        vars[p.first] = getRealFromModel(m, p.second);
+        const option<GiNaC::numeric> &val = getRealFromModel(m, p.second);
+        if (val) {
+            vars[p.first] = val.get();
+        }
     }
     std::map<unsigned int, bool> constants;
     for (const auto &p: ctx.getConstMap()) {
         int32_t val;
-        if (yices_get_bool_value(m, p.second, &val) != 0) {
-            throw YicesError();
+        if (yices_get_bool_value(m, p.second, &val) == 0) {
+            constants[p.first] = val;
         }
-        constants[p.first] = val;
     }
     yices_free_model(m);
     return Model(vars, constants);
@@ -84,10 +85,12 @@ void Yices::setTimeout(unsigned int timeout) {
 
 void Yices::enableModels() { }
 
-GiNaC::numeric Yices::getRealFromModel(model_t *model, type_t symbol) {
+option<GiNaC::numeric> Yices::getRealFromModel(model_t *model, type_t symbol) {
     int64_t num;
     uint64_t denom;
-    yices_get_rational64_value(model, symbol, &num, &denom);
+    if (yices_get_rational64_value(model, symbol, &num, &denom) != 0) {
+        return {};
+    }
     assert(denom != 0);
     GiNaC::numeric res = num;
     res = res / denom;
@@ -95,9 +98,14 @@ GiNaC::numeric Yices::getRealFromModel(model_t *model, type_t symbol) {
 }
 
 void Yices::resetSolver() {
+    Smt::resetSolver();
     yices_reset_context(solver);
 }
 
+void Yices::interrupt() {
+    yices_stop_search(solver);
+}
+
 std::pair<Smt::Result, BoolExprSet> Yices::_unsatCore(const BoolExprSet &assumptions) {
     std::vector<term_t> as;
     std::map<term_t, BoolExpr> map;
@@ -106,26 +114,23 @@ std::pair<Smt::Result, BoolExprSet> Yices::_unsatCore(const BoolExprSet &assumpt
         as.push_back(t);
         map.emplace(t, a);
     }
-    auto future = std::async(yices_check_context_with_assumptions, solver, nullptr, as.size(), &as[0]);
-    if (future.wait_for(std::chrono::milliseconds(timeout)) != std::future_status::timeout) {
-        switch (future.get()) {
-        case STATUS_SAT:
-            return {Sat, {}};
-        case STATUS_UNSAT: {
-            term_vector_t core;
-            yices_init_term_vector(&core);
-            yices_get_unsat_core(solver, &core);
-            BoolExprSet res;
-            for (unsigned int i = 0; i < core.size; ++i) {
-                res.insert(map[core.data[i]]);
-            }
-            return {Unsat, res};
-        }
-        default:
-            return {Unknown, {}};
+    Watchdog::Ticket ticket = Watchdog::arm(std::chrono::milliseconds(timeout), [this]{yices_stop_search(solver);});
+    smt_status_t status = yices_check_context_with_assumptions(solver, nullptr, as.size(), &as[0]);
+    Watchdog::disarm(ticket);
+    switch (status) {
+    case STATUS_SAT:
+        return {Sat, {}};
+    case STATUS_UNSAT: {
+        term_vector_t core;
+        yices_init_term_vector(&core);
+        yices_get_unsat_core(solver, &core);
+        BoolExprSet res;
+        for (unsigned int i = 0; i < core.size; ++i) {
+            res.insert(map[core.data[i]]);
         }
-    } else {
-        yices_stop_search(solver);
+        return {Unsat, res};
+    }
+    default:
         return {Unknown, {}};
     }
 }
@@ -15,11 +15,11 @@ public:
     void add(const BoolExpr e) override;
     void push() override;
     void pop() override;
-    Result check() override;
     Model model() override;
     void setTimeout(unsigned int timeout) override;
     void enableModels() override;
     void resetSolver() override;
+    void interrupt() override;
     ~Yices() override;
 
     static void init();
@@ -27,12 +27,11 @@ public:
 
     std::ostream& print(std::ostream& os) const;
 
+    Result _check() override;
     std::pair<Result, BoolExprSet> _unsatCore(const BoolExprSet &assumptions) override;
 
 private:
-    unsigned int timeout = Config::Smt::DefaultTimeout;
     YicesContext ctx;
-    const VariableManager &varMan;
     ctx_config_t *config;
     context_t *solver;
 
@@ -40,7 +39,7 @@ private:
     static std::mutex mutex;
 
 
-    GiNaC::numeric getRealFromModel(model_t *model, type_t symbol);
+    option<GiNaC::numeric> getRealFromModel(model_t *model, type_t symbol);
 
 };
 
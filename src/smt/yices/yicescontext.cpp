@@ -23,6 +23,8 @@ YicesError::YicesError() : std::exception() {
     yices_print_error(stderr);
 }
 
+YicesContext::YicesContext(unsigned conversionCacheSize): SmtContext(conversionCacheSize) { }
+
 YicesContext::~YicesContext() { }
 
 term_t YicesContext::buildVar(const std::string &name, Expr::Type type) {
@@ -35,6 +35,7 @@ public:
 class YicesContext : public SmtContext<term_t> {
 
 public:
+    YicesContext(unsigned conversionCacheSize = Config::Smt::ConversionCacheSize);
     ~YicesContext() override;
     term_t getInt(long val) override;
     term_t getReal(long num, long denom) override;
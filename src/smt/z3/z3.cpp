@@ -2,17 +2,66 @@
 #include "../exprtosmt.hpp"
 #include "../smttoexpr.hpp"
 
+#include <chrono>
+#include <iomanip>
+
+std::atomic_ulong Z3::contexts(0);
+std::atomic_ulong Z3::simplifications(0);
+std::atomic_ulong Z3::checkNanos(0);
+std::atomic_ulong Z3::simplifyNanos(0);
+std::atomic_ulong Z3::simplifyCacheHits(0);
+std::mutex Z3::simplifyCacheMutex;
+
+namespace {
+
+    unsigned long nanosSince(const std::chrono::steady_clock::time_point &start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+}
+
+/**
+ * Constructing a z3 context is expensive, so all solvers on the same thread share one.
+ * Solvers keep their own Z3Context (i.e., their own variable mapping), so they do not interfere.
+ */
+std::shared_ptr<z3::context> Z3::threadContext() {
+    thread_local std::shared_ptr<z3::context> z3Ctx;
+    if (!z3Ctx) {
+        z3Ctx = std::make_shared<z3::context>();
+        ++contexts;
+    }
+    return z3Ctx;
+}
+
+/**
+ * The ctx-solver-simplify tactic is built once per thread and reset before every use.
+ */
+z3::solver& Z3::threadSimplifier() {
+    // keeps the context alive until the solver has been destructed
+    thread_local std::shared_ptr<z3::context> z3Ctx = threadContext();
+    thread_local z3::solver simplifier = z3::tactic(*z3Ctx, "ctx-solver-simplify").mk_solver();
+    return simplifier;
+}
+
 std::ostream& Z3::print(std::ostream& os) const {
     return os << solver;
 }
 
 Z3::~Z3() {}
 
-Z3::Z3(const VariableManager &varMan): varMan(varMan), ctx(z3Ctx), solver(z3Ctx) {
+Z3::Z3(const VariableManager &varMan, Logic logic, bool sharedContext):
+    Smt(varMan, logic),
+    z3Ctx(sharedContext ? threadContext() : std::make_shared<z3::context>()),
+    ctx(*z3Ctx),
+    solver(*z3Ctx) {
+    if (!sharedContext) {
+        ++contexts;
+    }
     updateParams();
 }
 
 void Z3::add(const BoolExpr e) {
+    Smt::add(e);
     solver.add(ExprToSmt<z3::expr>::convert(e, ctx, varMan));
 }
 
@@ -26,8 +75,11 @@ void Z3::pop() {
     solver.pop();
 }
 
-Smt::Result Z3::check() {
-    switch (solver.check()) {
+Smt::Result Z3::_check() {
+    auto start = std::chrono::steady_clock::now();
+    z3::check_result res = solver.check();
+    checkNanos += nanosSince(start);
+    switch (res) {
     case z3::sat: return Sat;
     case z3::unsat: return Unsat;
     case z3::unknown: return Unknown;
@@ -60,7 +112,7 @@ void Z3::enableModels() {
 }
 
 void Z3::updateParams() {
-    z3::params params(z3Ctx);
+    z3::params params(*z3Ctx);
     params.set(":model", models);
     params.set(":timeout", timeout);
     solver.set(params);
@@ -87,7 +139,9 @@ std::pair<Smt::Result, BoolExprSet> Z3::_unsatCore(const BoolExprSet &assumption
         assert(map.count(key) == 0);
         map.emplace(key, a);
     }
+    auto start = std::chrono::steady_clock::now();
     auto z3res = solver.check(as.size(), &as[0]);
+    checkNanos += nanosSince(start);
     if (z3res == z3::unsat) {
         z3::expr_vector core = solver.unsat_core();
         BoolExprSet res;
@@ -105,21 +159,56 @@ std::pair<Smt::Result, BoolExprSet> Z3::_unsatCore(const BoolExprSet &assumption
 }
 
 void Z3::resetSolver() {
+    Smt::resetSolver();
     solver.reset();
     updateParams();
 }
 
+size_t Z3::SimplifyHash::operator()(const SimplifyKey &key) const {
+    return 31 * key.first->hash() + key.second;
+}
+
+LruCache<Z3::SimplifyKey, BoolExpr, Z3::SimplifyHash>& Z3::simplifyCache() {
+    static LruCache<SimplifyKey, BoolExpr, SimplifyHash> cache(Config::Smt::SimpCacheSize);
+    return cache;
+}
+
+/**
+ * Interrupting z3 affects the whole context, and it may stay interrupted if no check is running.
+ * So the solver (and any other solver sharing its context) should be discarded afterwards.
+ */
+void Z3::interrupt() {
+    z3Ctx->interrupt();
+}
+
 BoolExpr Z3::simplify(const BoolExpr expr, const VariableManager &varMan, unsigned int timeout) {
-    z3::context z3Ctx;
-    Z3Context ctx(z3Ctx);
-    z3::tactic t(z3Ctx, "ctx-solver-simplify");
-    z3::solver s = t.mk_solver();
-    z3::params params(z3Ctx);
+    {
+        std::lock_guard<std::mutex> lock(simplifyCacheMutex);
+        const BoolExpr *cached = simplifyCache().get({expr, timeout});
+        if (cached) {
+            ++simplifyCacheHits;
+            return *cached;
+        }
+    }
+    const BoolExpr res = runSimplifier(expr, varMan, timeout);
+    std::lock_guard<std::mutex> lock(simplifyCacheMutex);
+    simplifyCache().put({expr, timeout}, res);
+    return res;
+}
+
+BoolExpr Z3::runSimplifier(const BoolExpr expr, const VariableManager &varMan, unsigned int timeout) {
+    auto start = std::chrono::steady_clock::now();
+    z3::solver &s = threadSimplifier();
+    s.reset();
+    Z3Context ctx(s.ctx());
+    z3::params params(s.ctx());
     params.set(":timeout", timeout);
     s.set(params);
     const z3::expr &converted = ExprToSmt<z3::expr>::convert(expr, ctx, varMan);
     s.add(converted);
     s.check();
+    ++simplifications;
+    simplifyNanos += nanosSince(start);
     std::vector<BoolExpr> simplified;
     for (const z3::expr &e: s.assertions()) {
         option<BoolExpr> simp = SmtToExpr<z3::expr>::convert(e, ctx);
@@ -128,3 +217,10 @@ BoolExpr Z3::simplify(const BoolExpr expr, const VariableManager &varMan, unsign
     }
     return buildAnd(simplified);
 }
+
+void Z3::printStatistics(std::ostream &s) {
+    s << "Z3: " << contexts << " contexts, " << simplifications << " simplifications" << std::endl;
+    s << "  simplification cache: " << simplifyCacheHits << " hits (tactic runs saved)" << std::endl;
+    s << "  time: " << std::fixed << std::setprecision(2) << checkNanos / 1e6 << "ms checking, "
+      << simplifyNanos / 1e6 << "ms simplifying" << std::endl;
+}
@@ -4,39 +4,80 @@
 #include "../smt.hpp"
 #include "z3context.hpp"
 #include "../../config.hpp"
+#include "../../util/lrucache.hpp"
+#include "../../util/budget.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <utility>
 
 class Z3 : public Smt {
 
 public:
-    Z3(const VariableManager &varMan);
+    /**
+     * @param sharedContext whether to use the context that is shared by all instances on the current thread,
+     * should only be false if the solver is going to be interrupted
+     */
+    Z3(const VariableManager &varMan, Logic logic, bool sharedContext = true);
 
     void add(const BoolExpr e) override;
     void push() override;
     void pop() override;
-    Result check() override;
     Model model() override;
     void setTimeout(unsigned int timeout) override;
     void enableModels() override;
     void resetSolver() override;
+    void interrupt() override;
     ~Z3() override;
 
     std::ostream& print(std::ostream& os) const;
 
-    static BoolExpr simplify(const BoolExpr expr, const VariableManager &varMan, unsigned int timeout = Config::Smt::SimpTimeout);
+    /**
+     * Simplifies the given formula with z3's ctx-solver-simplify tactic.
+     * Results are cached, so simplifying the same formula with the same timeout again is cheap.
+     */
+    static BoolExpr simplify(const BoolExpr expr, const VariableManager &varMan, unsigned int timeout = Budget::timeout(Budget::Simplification));
 
+    Result _check() override;
     std::pair<Result, BoolExprSet> _unsatCore(const BoolExprSet &assumptions) override;
 
+    /**
+     * Prints the number of z3 contexts, simplifications and the time spent in z3 (for all threads).
+     */
+    static void printStatistics(std::ostream &s);
+
 private:
     bool models = false;
-    unsigned int timeout = Config::Smt::DefaultTimeout;
-    const VariableManager &varMan;
-    z3::context z3Ctx;
+    // shared by all instances on the same thread, must be declared before ctx and solver
+    std::shared_ptr<z3::context> z3Ctx;
     Z3Context ctx;
     z3::solver solver;
 
     GiNaC::numeric getRealFromModel(const z3::model &model, const z3::expr &symbol);
     void updateParams();
 
+    static std::shared_ptr<z3::context> threadContext();
+    static z3::solver& threadSimplifier();
+    static BoolExpr runSimplifier(const BoolExpr expr, const VariableManager &varMan, unsigned int timeout);
+
+    // the result depends on the timeout, so it is part of the key
+    typedef std::pair<BoolExpr, unsigned int> SimplifyKey;
+
+    struct SimplifyHash {
+        size_t operator()(const SimplifyKey &key) const;
+    };
+
+    static LruCache<SimplifyKey, BoolExpr, SimplifyHash>& simplifyCache();
+    static std::mutex simplifyCacheMutex;
+
+    static std::atomic_ulong contexts;
+    static std::atomic_ulong simplifications;
+    static std::atomic_ulong checkNanos;
+    static std::atomic_ulong simplifyNanos;
+    static std::atomic_ulong simplifyCacheHits;
+
 };
 
 #endif // Z3_HPP
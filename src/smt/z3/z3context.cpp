@@ -19,7 +19,7 @@
 
 using namespace std;
 
-Z3Context::Z3Context(z3::context& ctx): ctx(ctx) { }
+Z3Context::Z3Context(z3::context& ctx, unsigned conversionCacheSize): SmtContext(conversionCacheSize), ctx(ctx) { }
 
 Z3Context::~Z3Context() { }
 
@@ -38,7 +38,7 @@
 class Z3Context : public SmtContext<z3::expr> {
 
 public:
-    Z3Context(z3::context& ctx);
+    Z3Context(z3::context& ctx, unsigned conversionCacheSize = Config::Smt::ConversionCacheSize);
     ~Z3Context() override;
     z3::expr getInt(long val) override;
     z3::expr getReal(long num, long denom) override;
@@ -0,0 +1,79 @@
+#include "budget.hpp"
+#include "timeout.hpp"
+#include "../config.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace std;
+
+namespace {
+
+    atomic_int phase(Budget::Simplify);
+    // unused time of the simplification phase (in ms) that has not yet been handed out to final limit problems
+    atomic_long credit(0);
+    // the credit at the start of the final phase (in ms)
+    atomic_long initialCredit(0);
+
+    atomic_ulong queries(0);
+    atomic_ulong shortened(0);
+    atomic_ulong stretched(0);
+
+    unsigned int defaultTimeout(Budget::Query query) {
+        switch (query) {
+        case Budget::Default: return Config::Smt::DefaultTimeout;
+        case Budget::Meter: return Config::Smt::MeterTimeout;
+        case Budget::Limit: return Config::Smt::LimitTimeout;
+        case Budget::LimitFinal: return Timeout::soft() ? Config::Smt::LimitTimeoutFinalFast : Config::Smt::LimitTimeoutFinal;
+        case Budget::Simplification: return Config::Smt::SimpTimeout;
+        }
+        return Config::Smt::DefaultTimeout;
+    }
+
+    long remainingMillis() {
+        chrono::seconds remaining = (phase == Budget::Finalize || Timeout::soft()) ? Timeout::remainingHard() : Timeout::remainingSoft();
+        return chrono::duration_cast<chrono::milliseconds>(remaining).count();
+    }
+
+}
+
+unsigned int Budget::timeout(Query query, unsigned int pending) {
+    unsigned int res = defaultTimeout(query);
+    if (!Timeout::enabled()) {
+        return res;
+    }
+    ++queries;
+    long share = remainingMillis() / (max(1u, pending) * Config::Smt::BudgetShare);
+    if (query == LimitFinal && phase == Finalize && share >= res) {
+        // the simplification left time for the final limit problems, which is divided among the pending ones
+        long available = credit.load();
+        if (available > 0) {
+            long bonus = available / max(1u, pending);
+            long stretch = min<long>({share, res * Config::Smt::MaxTimeoutStretch, res + bonus});
+            if (stretch > res) {
+                credit -= stretch - res;
+                ++stretched;
+                return static_cast<unsigned int>(stretch);
+            }
+        }
+    }
+    if (share < res) {
+        ++shortened;
+        return static_cast<unsigned int>(max<long>(share, Config::Smt::MinTimeout));
+    }
+    return res;
+}
+
+void Budget::startPhase(Phase next) {
+    if (next == Finalize && Timeout::enabled() && !Timeout::soft()) {
+        credit = chrono::duration_cast<chrono::milliseconds>(Timeout::remainingSoft()).count();
+        initialCredit = credit.load();
+    }
+    phase = next;
+}
+
+void Budget::printStatistics(ostream &s) {
+    s << "Time budget: " << queries << " timeouts computed, " << shortened << " shortened, "
+      << stretched << " stretched (unused simplification time: " << max(0l, initialCredit.load()) << "ms, "
+      << max(0l, initialCredit.load() - max(0l, credit.load())) << "ms of it handed out)" << endl;
+}
@@ -0,0 +1,33 @@
+#ifndef BUDGET_HPP
+#define BUDGET_HPP
+
+#include <ostream>
+
+/**
+ * Hands out timeouts for SMT queries based on the remaining time (see Timeout).
+ *
+ * Without a global timeout, the constants from Config::Smt are used. Otherwise, a query gets its
+ * timeout from Config::Smt, but at most a fraction (Config::Smt::BudgetShare) of the time that is left
+ * until the current deadline, divided among the given number of pending queries. The current deadline
+ * is the soft timeout during simplification and the hard timeout afterwards.
+ *
+ * If the simplification finishes before the soft timeout, the time that is left is a credit that is
+ * divided among the final limit problems, which may then be given longer timeouts
+ * (up to Config::Smt::MaxTimeoutStretch times the default). Every stretched timeout consumes its
+ * extra time from the credit.
+ */
+namespace Budget {
+
+    enum Query {Default, Meter, Limit, LimitFinal, Simplification};
+
+    enum Phase {Simplify, Finalize};
+
+    // timeout (in ms) for a query of the given kind, where pending is the number of similar queries that are still to come
+    unsigned int timeout(Query query, unsigned int pending = 1);
+
+    void startPhase(Phase phase);
+
+    void printStatistics(std::ostream &s);
+}
+
+#endif // BUDGET_HPP
@@ -72,7 +72,9 @@ BoolExpr FarkasLemma::apply(
         Expr lambdaA = 0;
         bool first = true;
         for (const auto &e: lambda) {
-            Expr a = e.first.lhs().expand().coeff(varIt.first);
+            // the rhs does not contain any variables from varToCoeff (see splitVariableAndConstantAddends)
+            const LinearForm *form = e.first.linearForm();
+            Expr a = form ? Expr(form->coeff(varIt.first)) : e.first.lhs().expand().coeff(varIt.first);
             Expr add = e.second * a;
             lambdaA = first ? add : lambdaA + add; // avoid superflous +0
             first = false;
@@ -137,8 +139,9 @@ const BoolExpr FarkasLemma::applyRec(
     if (premise->isConjunction()) {
         for (const Rel &c: conclusion) {
             vector<Expr> coefficients;
+            const LinearForm *form = c.linearForm();
             for (const Var &x : vars) {
-                coefficients.push_back(c.lhs().coeff(x, 1));
+                coefficients.push_back(form ? Expr(form->coeff(x)) : c.lhs().coeff(x, 1));
             }
             Expr c0 = -c.rhs();
             RelSet lits;
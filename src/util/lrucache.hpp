@@ -0,0 +1,83 @@
+#ifndef LRUCACHE_HPP
+#define LRUCACHE_HPP
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+/**
+ * A map with a bounded number of entries. If it is full, the least recently used entry is evicted.
+ *
+ * Not thread-safe, users have to synchronize accesses themselves.
+ */
+template<class Key, class Value, class Hash = std::hash<Key>, class Equal = std::equal_to<Key>>
+class LruCache {
+
+    typedef std::list<std::pair<Key, Value>> Entries;
+
+public:
+
+    LruCache(size_t capacity): capacity(capacity) {}
+
+    // the index refers to the nodes of entries, which are only preserved when moving
+    LruCache(const LruCache &that) = delete;
+    LruCache& operator=(const LruCache &that) = delete;
+    LruCache(LruCache &&that) = default;
+    LruCache& operator=(LruCache &&that) = default;
+
+    /**
+     * @return the value stored for the given key (and marks it as most recently used), or nullptr
+     */
+    Value* get(const Key &key) {
+        auto it = index.find(key);
+        if (it == index.end()) {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * Inserts the given entry (or overwrites the value for the given key)
+     * and evicts the least recently used entry if the capacity is exceeded.
+     */
+    void put(const Key &key, const Value &value) {
+        auto it = index.find(key);
+        if (it != index.end()) {
+            it->second->second = value;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        entries.emplace_front(key, value);
+        index.emplace(key, entries.begin());
+        if (entries.size() > capacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+            ++evictions;
+        }
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    void clear() {
+        index.clear();
+        entries.clear();
+    }
+
+    unsigned long getEvictions() const {
+        return evictions;
+    }
+
+private:
+
+    size_t capacity;
+    // most recently used entries first
+    Entries entries;
+    std::unordered_map<Key, typename Entries::iterator, Hash, Equal> index;
+    unsigned long evictions = 0;
+
+};
+
+#endif // LRUCACHE_HPP
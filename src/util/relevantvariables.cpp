@@ -72,6 +72,53 @@ namespace util {
         return symbols;
     }
 
+    const VarSet RelevantVariables::find(
+            const VarSet &varsOfInterest,
+            const std::vector<Subs> &updates,
+            const BoolExpr guard,
+            const VariableManager &varMan) {
+        std::vector<std::map<VarId, VarIdSet>> updateVars;
+        for (const Subs &up: updates) {
+            std::map<VarId, VarIdSet> m;
+            for (const auto &p: up) {
+                m.emplace(varMan.getId(p.first), varMan.getIds(p.second.vars()));
+            }
+            updateVars.push_back(std::move(m));
+        }
+        std::vector<VarIdSet> litVars;
+        for (const Rel &rel: guard->lits()) {
+            litVars.push_back(varMan.getIds(rel.vars()));
+        }
+        VarIdSet res = varMan.getIds(varsOfInterest);
+        // Compute the closure of res under all updates and the guard
+        VarIdSet todo = res;
+        while (!todo.empty()) {
+            VarIdSet next;
+            for (VarId x: todo) {
+                for (const auto &up: updateVars) {
+                    auto it = up.find(x);
+                    if (it != up.end()) {
+                        next.insertAll(it->second);
+                    }
+                }
+            }
+            for (const VarIdSet &relVars: litVars) {
+                if (relVars.intersects(todo)) {
+                    next.insertAll(relVars);
+                }
+            }
+            todo.clear();
+            for (VarId x: next) {
+                if (!res.contains(x)) {
+                    todo.insert(x);
+                }
+            }
+            // collect all variables from every iteration
+            res.insertAll(todo);
+        }
+        return varMan.getVars(res);
+    }
+
 
     const VarSet RelevantVariables::find(
             const Guard &constraints,
@@ -22,6 +22,8 @@
 #include "../its/types.hpp"
 #include "../its/rule.hpp"
 
+class VariableManager;
+
 namespace util {
 
     class RelevantVariables {
@@ -33,6 +35,16 @@ namespace util {
                 const std::vector<Subs> &updates,
                 const BoolExpr guard);
 
+        /**
+         * Same as above, but computes the closure on dense variable ids (see VarIdSet),
+         * which is considerably faster if there are many variables.
+         */
+        static const VarSet find(
+                const VarSet &varsOfInterest,
+                const std::vector<Subs> &updates,
+                const BoolExpr guard,
+                const VariableManager &varMan);
+
         static const VarSet find(
                 const Guard &constraints,
                 const std::vector<Subs> &updates,
@@ -0,0 +1,66 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <memory>
+
+/**
+ * A read-only view of an immutable object (usually a container) that is shared with its owner.
+ *
+ * The owner never modifies an object once it has been handed out, but replaces it with a fresh one,
+ * so a snapshot remains valid (and unchanged) even if the owner is modified in the meantime
+ * (e.g., while iterating over the snapshot or after the owner has discarded the object).
+ * Hence, it can be used just like a copy of the object, but creating it does not allocate.
+ * Callers that want to modify the object have to copy it explicitly (e.g., via operator*).
+ */
+template <class T>
+class Snapshot {
+
+public:
+
+    explicit Snapshot(std::shared_ptr<const T> data): data(std::move(data)) {}
+
+    // the following members are only available for containers
+
+    auto begin() const {
+        return data->begin();
+    }
+
+    auto end() const {
+        return data->end();
+    }
+
+    size_t size() const {
+        return data->size();
+    }
+
+    bool empty() const {
+        return data->empty();
+    }
+
+    // only available for random access containers
+    decltype(auto) operator[](size_t i) const {
+        return (*data)[i];
+    }
+
+    const T& operator*() const {
+        return *data;
+    }
+
+    const T* operator->() const {
+        return data.get();
+    }
+
+    /**
+     * @return the underlying object, which lives at least as long as this snapshot
+     */
+    const T& get() const {
+        return *data;
+    }
+
+private:
+
+    std::shared_ptr<const T> data;
+
+};
+
+#endif // SNAPSHOT_HPP
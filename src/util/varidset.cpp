@@ -0,0 +1,103 @@
+#include "varidset.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+VarIdSet::VarIdSet() {}
+
+VarIdSet::VarIdSet(std::initializer_list<VarId> ids): ids(ids) {
+    std::sort(this->ids.begin(), this->ids.end());
+    this->ids.erase(std::unique(this->ids.begin(), this->ids.end()), this->ids.end());
+}
+
+void VarIdSet::insert(VarId id) {
+    // ids are typically inserted in ascending order, so check the back first
+    if (ids.empty() || ids.back() < id) {
+        ids.push_back(id);
+        return;
+    }
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (*it != id) {
+        ids.insert(it, id);
+    }
+}
+
+void VarIdSet::insertAll(const VarIdSet &that) {
+    if (that.ids.empty() || includes(that)) {
+        return;
+    }
+    ids = unite(that).ids;
+}
+
+bool VarIdSet::erase(VarId id) {
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+    if (it == ids.end() || *it != id) {
+        return false;
+    }
+    ids.erase(it);
+    return true;
+}
+
+bool VarIdSet::contains(VarId id) const {
+    return std::binary_search(ids.begin(), ids.end(), id);
+}
+
+bool VarIdSet::includes(const VarIdSet &that) const {
+    return that.ids.size() <= ids.size() && std::includes(ids.begin(), ids.end(), that.ids.begin(), that.ids.end());
+}
+
+bool VarIdSet::intersects(const VarIdSet &that) const {
+    auto it1 = ids.begin();
+    auto it2 = that.ids.begin();
+    while (it1 != ids.end() && it2 != that.ids.end()) {
+        if (*it1 < *it2) {
+            ++it1;
+        } else if (*it2 < *it1) {
+            ++it2;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+VarIdSet VarIdSet::unite(const VarIdSet &that) const {
+    VarIdSet res;
+    res.ids.reserve(ids.size() + that.ids.size());
+    std::set_union(ids.begin(), ids.end(), that.ids.begin(), that.ids.end(), std::back_inserter(res.ids));
+    return res;
+}
+
+VarIdSet VarIdSet::intersect(const VarIdSet &that) const {
+    VarIdSet res;
+    std::set_intersection(ids.begin(), ids.end(), that.ids.begin(), that.ids.end(), std::back_inserter(res.ids));
+    return res;
+}
+
+std::size_t VarIdSet::size() const {
+    return ids.size();
+}
+
+bool VarIdSet::empty() const {
+    return ids.empty();
+}
+
+void VarIdSet::clear() {
+    ids.clear();
+}
+
+VarIdSet::const_iterator VarIdSet::begin() const {
+    return ids.begin();
+}
+
+VarIdSet::const_iterator VarIdSet::end() const {
+    return ids.end();
+}
+
+bool VarIdSet::operator==(const VarIdSet &that) const {
+    return ids == that.ids;
+}
+
+bool VarIdSet::operator!=(const VarIdSet &that) const {
+    return ids != that.ids;
+}
@@ -0,0 +1,54 @@
+#ifndef VARIDSET_HPP
+#define VARIDSET_HPP
+
+#include <cstddef>
+#include <vector>
+#include <initializer_list>
+
+/**
+ * Dense integer id of a variable, as assigned by the VariableManager.
+ */
+typedef unsigned VarId;
+
+/**
+ * A compact set of variable ids, stored as a sorted vector.
+ *
+ * Intended for hot paths that compute closures, unions or subset tests of variable sets,
+ * where std::set<Var, ex_is_less> is dominated by allocations and GiNaC comparisons.
+ * Use VariableManager::getIds and VariableManager::getVars to convert from and to VarSet.
+ */
+class VarIdSet {
+public:
+
+    typedef std::vector<VarId>::const_iterator const_iterator;
+
+    VarIdSet();
+    VarIdSet(std::initializer_list<VarId> ids);
+
+    void insert(VarId id);
+    void insertAll(const VarIdSet &that);
+    bool erase(VarId id);
+
+    bool contains(VarId id) const;
+    // returns true iff every element of that is contained in this set
+    bool includes(const VarIdSet &that) const;
+    bool intersects(const VarIdSet &that) const;
+
+    VarIdSet unite(const VarIdSet &that) const;
+    VarIdSet intersect(const VarIdSet &that) const;
+
+    std::size_t size() const;
+    bool empty() const;
+    void clear();
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    bool operator==(const VarIdSet &that) const;
+    bool operator!=(const VarIdSet &that) const;
+
+private:
+    std::vector<VarId> ids;
+};
+
+#endif // VARIDSET_HPP
@@ -0,0 +1,91 @@
+#include "watchdog.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+typedef chrono::time_point<chrono::steady_clock> Deadline;
+
+namespace {
+
+    struct State {
+        mutex m;
+        condition_variable cv;
+        // ordered by deadline, the ticket makes the key unique
+        map<pair<Deadline, Watchdog::Ticket>, function<void()>> pending;
+        map<Watchdog::Ticket, Deadline> deadlines;
+        Watchdog::Ticket nextTicket = 0;
+        bool started = false;
+    };
+
+    // Never destructed, since the detached timer thread may still access it during shutdown
+    State& state() {
+        static State *state = new State();
+        return *state;
+    }
+
+    atomic_ulong armedCount(0);
+    atomic_ulong firedCount(0);
+    atomic_ulong threadCount(0);
+
+    void run() {
+        State &s = state();
+        unique_lock<mutex> lock(s.m);
+        while (true) {
+            if (s.pending.empty()) {
+                s.cv.wait(lock);
+                continue;
+            }
+            auto first = s.pending.begin();
+            if (first->first.first > chrono::steady_clock::now()) {
+                s.cv.wait_until(lock, first->first.first);
+                continue;
+            }
+            // the callback is executed while holding the lock, so that disarm() waits for it
+            first->second();
+            s.deadlines.erase(first->first.second);
+            s.pending.erase(first);
+            ++firedCount;
+        }
+    }
+
+}
+
+Watchdog::Ticket Watchdog::arm(chrono::milliseconds timeout, function<void()> callback) {
+    State &s = state();
+    lock_guard<mutex> lock(s.m);
+    if (!s.started) {
+        thread(run).detach();
+        s.started = true;
+        ++threadCount;
+    }
+    Ticket ticket = s.nextTicket++;
+    Deadline deadline = chrono::steady_clock::now() + timeout;
+    s.pending.emplace(make_pair(deadline, ticket), callback);
+    s.deadlines.emplace(ticket, deadline);
+    ++armedCount;
+    s.cv.notify_one();
+    return ticket;
+}
+
+bool Watchdog::disarm(Ticket ticket) {
+    State &s = state();
+    lock_guard<mutex> lock(s.m);
+    auto it = s.deadlines.find(ticket);
+    if (it == s.deadlines.end()) {
+        return true;
+    }
+    s.pending.erase(make_pair(it->second, ticket));
+    s.deadlines.erase(it);
+    return false;
+}
+
+void Watchdog::printStatistics(ostream &s) {
+    s << "Watchdog: " << armedCount << " deadlines armed, " << firedCount << " expired" << endl;
+    s << "  threads started for timeouts: " << threadCount
+      << " (one thread per deadline would have started " << armedCount << ")" << endl;
+}
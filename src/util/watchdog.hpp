@@ -0,0 +1,30 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+/**
+ * A single, shared timer thread that calls a given function once a deadline has passed.
+ * This allows to enforce timeouts on blocking calls (e.g. yices_check_context)
+ * without starting a new thread for every call.
+ *
+ * Callbacks are executed on the timer thread, so they must be cheap and thread-safe.
+ * disarm() waits for a running callback to finish, so after it returns, the callback
+ * will never be executed for the given ticket.
+ */
+namespace Watchdog {
+
+    typedef unsigned long Ticket;
+
+    // calls callback after the given timeout, unless the returned ticket is disarmed before
+    Ticket arm(std::chrono::milliseconds timeout, std::function<void()> callback);
+
+    // returns true iff the callback has already been executed
+    bool disarm(Ticket ticket);
+
+    void printStatistics(std::ostream &s);
+}
+
+#endif // WATCHDOG_H
@@ -0,0 +1,52 @@
+#!/bin/bash
+
+# Runs LoAT with --stats on all .koat files below the given directory (example/ by default)
+# and sums up the time spent in z3 (see Z3::printStatistics), to compare z3 settings or versions.
+
+ME=`basename "$0"`
+
+if [ "$1" == "--help" ] || [ $# -gt 3 ]; then
+    echo "usage: ./$ME [<loat binary> [<timeout in seconds> [<directory>]]]"
+    echo "defaults: build/static/release/loat-static, 60, example"
+    exit 1
+fi
+
+LOAT=${1:-build/static/release/loat-static}
+TIMEOUT=${2:-60}
+DIR=${3:-example}
+
+if [ ! -x "$LOAT" ]; then
+    echo "$ME: cannot execute $LOAT"
+    exit 1
+fi
+
+STATS=`mktemp`
+trap "rm -f $STATS" EXIT
+
+total_check=0
+total_simp=0
+files=0
+missing=0
+
+while IFS= read -r -d '' file; do
+    "$LOAT" --plain --timeout "$TIMEOUT" --stats "$file" > /dev/null 2> "$STATS"
+    # the statistics contain a line "  time: <x>ms checking, <y>ms simplifying"
+    times=`grep -A2 "^Z3:" "$STATS" | sed -n 's/^ *time: \([0-9.]*\)ms checking, \([0-9.]*\)ms simplifying$/\1 \2/p'`
+    if [ -z "$times" ]; then
+        echo "$file: no z3 statistics"
+        missing=$((missing + 1))
+        continue
+    fi
+    read check simp <<< "$times"
+    printf "%s: %.2fms checking, %.2fms simplifying\n" "$file" "$check" "$simp"
+    total_check=`awk "BEGIN {printf \"%f\", $total_check + $check}"`
+    total_simp=`awk "BEGIN {printf \"%f\", $total_simp + $simp}"`
+    files=$((files + 1))
+done < <(find "$DIR" -name "*.koat" -print0 | sort -z)
+
+echo
+printf "total (%d files): %.2fms checking, %.2fms simplifying, %.2fms overall\n" \
+    "$files" "$total_check" "$total_simp" `awk "BEGIN {printf \"%f\", $total_check + $total_simp}"`
+if [ $missing -ne 0 ]; then
+    echo "($missing files without statistics, e.g. due to a crash)"
+fi